@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BENCH_BENCHMARK_H_
+#define BENCH_BENCHMARK_H_
+
+#include <prim/prim.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/*
+ * Minimal benchmark harness. benchmark() calls _op until at least _minSeconds
+ * have passed (and at least once), then prints one CSV row:
+ *   benchmark,parameters,iterations,total_s,per_op_ns
+ * The make bench target writes the header and collects all rows.
+ */
+
+// results are folded in here so the compiler can't drop the measured work
+extern volatile u64 benchmarkSink;
+
+template <typename Op>
+void benchmark(const std::string& _name, const std::string& _parameters,
+               Op _op, f64 _minSeconds = 0.25) {
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  f64 elapsed = 0;
+  u64 iterations = 0;
+  u64 batch = 1;
+  while (iterations == 0 || elapsed < _minSeconds) {
+    for (u64 idx = 0; idx < batch; idx++) {
+      benchmarkSink = benchmarkSink + _op();
+    }
+    iterations += batch;
+    elapsed = std::chrono::duration<f64>(Clock::now() - start).count();
+    // grow the batch so the clock is read rarely for tiny operations
+    if (elapsed < _minSeconds / 16) {
+      batch *= 2;
+    }
+  }
+  printf("%s,%s,%lu,%.6f,%.1f\n", _name.c_str(), _parameters.c_str(),
+         iterations, elapsed, elapsed * 1e9 / iterations);
+  fflush(stdout);
+}
+
+#endif  // BENCH_BENCHMARK_H_
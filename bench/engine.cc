@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <prim/prim.h>
+
+#include <string>
+
+#include "bench/Benchmark.h"
+#include "search/BisectionCache.h"
+#include "search/Engine.h"
+#include "search/MultilevelBisector.h"
+#include "search/RouterChannelCount.h"
+#include "search/WorkPool.h"
+
+volatile u64 benchmarkSink = 0;
+
+s32 main(s32 _argc, char** _argv) {
+  (void)_argc;  // unused
+  (void)_argv;  // unused
+
+  struct Scale {
+    u64 maxRadix;
+    u64 minTerminals;
+  };
+  const Scale scales[] = {
+    {64, 32768}, {100, 10000}, {128, 100000}, {200, 500000}};
+
+  RouterChannelCount calc;
+  MultilevelBisector bisector(1);
+  WorkPool workPool(1);
+
+  for (const Scale& scale : scales) {
+    std::string parameters =
+        "maxradix=" + std::to_string(scale.maxRadix) +
+        " minterminals=" + std::to_string(scale.minTerminals);
+
+    // every run starts with an empty bisection cache
+    benchmark("Engine::run cold", parameters, [&]() {
+        BisectionCache cache;
+        Engine engine(2, scale.maxRadix, 1, U32_MAX - 1, scale.minTerminals,
+                      scale.minTerminals * 2, 0.5, 10, &calc, &bisector, 1,
+                      &cache, &workPool);
+        engine.run();
+        return engine.results().size();
+      });
+
+    // repeated queries as in serve mode, only the bounds are recomputed
+    BisectionCache cache;
+    benchmark("Engine::run warm", parameters, [&]() {
+        Engine engine(2, scale.maxRadix, 1, U32_MAX - 1, scale.minTerminals,
+                      scale.minTerminals * 2, 0.5, 10, &calc, &bisector, 1,
+                      &cache, &workPool);
+        engine.run();
+        return engine.results().size();
+      });
+  }
+
+  return 0;
+}
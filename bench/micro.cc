@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench/Benchmark.h"
+#include "search/Engine.h"
+#include "search/GaloisField.h"
+#include "search/GraphExport.h"
+#include "search/HopCounts.h"
+#include "search/MultilevelBisector.h"
+#include "search/ResultHeap.h"
+#include "search/RouterChannelCount.h"
+#include "search/SlimflyBlock.h"
+#include "search/SlimflyGraph.h"
+#include "search/SpectralBisector.h"
+#include "search/util.h"
+#include "search/WorkPool.h"
+
+volatile u64 benchmarkSink = 0;
+
+s32 main(s32 _argc, char** _argv) {
+  (void)_argc;  // unused
+  (void)_argv;  // unused
+
+  const u32 widths[] = {23, 49, 101, 243};
+
+  // generator sets (Galois fields come from the process wide cache)
+  for (u32 width : widths) {
+    std::vector<u32> X;
+    std::vector<u32> X_i;
+    benchmark("createGeneratorSet", "width=" + std::to_string(width), [&]() {
+        return createGeneratorSet(width, SlimflyGraph::deltaOf(width), X,
+                                  X_i);
+      });
+  }
+
+  // primitive element tests over every nonzero element of a prime field
+  for (u32 width : {23u, 101u, 241u}) {
+    benchmark("isPrimitiveElement", "width=" + std::to_string(width), [&]() {
+        u64 count = 0;
+        for (u32 prim = 1; prim < width; prim++) {
+          count += isPrimitiveElement(width, prim);
+        }
+        return count;
+      });
+  }
+
+  // Galois field construction, bypassing the cache
+  for (u32 width : widths) {
+    benchmark("GaloisField", "width=" + std::to_string(width), [&]() {
+        GaloisField field(width);
+        return static_cast<u64>(field.primitive());
+      });
+  }
+
+  // router graph construction
+  for (u32 width : widths) {
+    benchmark("SlimflyGraph", "width=" + std::to_string(width), [&]() {
+        SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+        return graph.numEdges();
+      });
+  }
+
+  // graph export, written to a scratch file next to the benchmark output
+  for (u32 width : {49u, 101u}) {
+    SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+    const std::string path = "bench_graph.tmp";
+    benchmark("GraphExport::writeBinary", "width=" + std::to_string(width),
+              [&]() {
+        GraphExport::writeBinary(graph, path);
+        return graph.numEdges();
+      });
+    benchmark("GraphExport::writeMetis", "width=" + std::to_string(width),
+              [&]() {
+        GraphExport::writeMetis(graph, path);
+        return graph.numEdges();
+      });
+    remove(path.c_str());
+  }
+
+  // the bisection step
+  for (u32 width : {23u, 49u, 101u}) {
+    SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+    MultilevelBisector multilevel(1);
+    SpectralBisector spectral(1, 64);
+    benchmark("MultilevelBisector", "width=" + std::to_string(width), [&]() {
+        return multilevel.edgeCut(graph.offsets(), graph.neighbors(), 0);
+      });
+    benchmark("SpectralBisector", "width=" + std::to_string(width), [&]() {
+        return spectral.edgeCut(graph.offsets(), graph.neighbors(), 0);
+      });
+  }
+
+  // all-pairs hop counts of the --hopcounts analysis, single threaded
+  WorkPool workPool(1);
+  for (u32 width : {23u, 49u}) {
+    SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+    benchmark("computeHopCounts", "width=" + std::to_string(width), [&]() {
+        return computeHopCounts(graph.offsets(), graph.neighbors(),
+                                &workPool).diameter;
+      });
+  }
+
+  // what stage5 does with every accepted candidate: cost it and keep the
+  //  best results
+  RouterChannelCount calc;
+  for (u64 capacity : {10lu, 1000lu}) {
+    const u64 kCandidates = 10000;
+    std::vector<Slimfly> candidates(kCandidates);
+    u64 state = 1;
+    for (Slimfly& candidate : candidates) {
+      state = state * 6364136223846793005lu + 1442695040888963407lu;
+      candidate.width = 5 + (state >> 33) % 200;
+      candidate.routers = 2 * candidate.width * candidate.width;
+      candidate.channels = candidate.routers * (state >> 58);
+    }
+    ResultHeap heap(capacity);
+    benchmark("stage5", "capacity=" + std::to_string(capacity) +
+              " candidates=" + std::to_string(kCandidates), [&]() {
+        heap.clear();
+        for (Slimfly& candidate : candidates) {
+          candidate.cost = calc.cost(candidate);
+          heap.push(candidate);
+        }
+        return heap.size();
+      });
+  }
+
+  // per-candidate virtual cost() against one batch costs() call per block
+  {
+    const u64 kCandidates = 10000;
+    SlimflyBlock block;
+    u64 state = 1;
+    for (u64 idx = 0; idx < kCandidates; idx++) {
+      state = state * 6364136223846793005lu + 1442695040888963407lu;
+      Slimfly candidate = Slimfly();
+      candidate.width = 5 + (state >> 33) % 200;
+      candidate.routers = 2 * candidate.width * candidate.width;
+      candidate.channels = candidate.routers * (state >> 58);
+      block.push(candidate);
+    }
+    const CostFunction* costFunction = &calc;
+    std::string params = "candidates=" + std::to_string(kCandidates);
+    benchmark("CostFunction::cost", params, [&]() {
+        f64 sum = 0;
+        for (u64 idx = 0; idx < block.size(); idx++) {
+          sum += costFunction->cost(block.get(idx));
+        }
+        return (u64)sum;
+      });
+    benchmark("CostFunction::costs", params, [&]() {
+        costFunction->costs(&block);
+        return (u64)block.cost[block.size() - 1];
+      });
+  }
+
+  return 0;
+}
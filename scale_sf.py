@@ -10,74 +10,27 @@
 # Date:         Spring 2016
 # Notes:        - Based on script written by Nic McDonald for
 #                 the HyperX topology
-#               - For radix higher than 51, metis will output
-#                 error messages related to the configuration
-#                 file. These can (and are) ignored by the
-#                 script in the search for the largest
-#                 possible configuration
 ##############################################################
 
 import argparse
 import subprocess
 
-def getInfo(exe, maxradix, minterminals, minbandwidth):
-  cmd = ('{0} --maxradix {1} --minterminals {2} --minbandwidth {3} '
-         '--maxresults 1').format(
-           exe, maxradix, minterminals, minbandwidth)
-  stdout = subprocess.check_output(cmd, shell=True).decode('utf-8')
-  lines = stdout.split('\n')
-  if len(lines) < 3:
-    return None
-  else:
-    best = lines[1].split()
-    routers = float(best[5])
-    channels = float(best[7])
-    return routers, channels
-
 def main(args):
   if args.verbose:
     print(args)
-  
-  print('radix,terms,routers,channels,terms/router,channels/term')
-  for radix in range(args.minradix, args.maxradix+1, 1):
-    if args.verbose:
-      print('working on radix {0}'.format(radix))
-
-    terms = None
-    routers = None
-    channels = None
-
-    bot = 2
-    maxdimensions = 2
-    top = radix**(maxdimensions+1)
-
-    # verify top is unachievable
-    info = getInfo(args.slimflysearch, radix, top, args.minbandwidth)
-    assert info is None, 'The programmer is an idiot!'
-
-    # use a binary search to find the largest network possible
-    while True:
-      assert bot <= top
-      mid = ((top - bot) // 2) + bot
-      info = getInfo(args.slimflysearch, radix, mid, args.minbandwidth)
 
-      if args.verbose:
-        print('bot={0} top={1} mid={2} solution={3}'.format(
-          bot, top, mid, False if info is None else True))
-
-      if bot == mid:
-        assert info is not None
-        terms = mid
-        routers, channels = info
-        break
-
-      if info is None:
-        top = mid - 1
-      else:
-        bot = mid
-
-    print('{0},{1},{2},{3},{4},{5}'.format(radix, terms, routers, channels,
-                                           terms / routers, channels / terms))
+  # the search binary sweeps the whole radix range in a single run
+  cmd = ('{0} --sweepradix {1}:{2} --minbandwidth {3}').format(
+    args.slimflysearch, args.minradix, args.maxradix, args.minbandwidth)
+  if args.cache:
+    cmd += ' --bisectioncache {0}'.format(args.cache)
+  if args.verbose:
+    print('running {0}'.format(cmd))
+  stdout = subprocess.check_output(cmd, shell=True).decode('utf-8')
+  for line in stdout.splitlines():
+    assert not line.endswith(',,,,,'), \
+      'no Slim Fly found for radix {0}'.format(line.split(',')[0])
+  print(stdout, end='')
 
 if __name__ == '__main__':
   ap = argparse.ArgumentParser()
@@ -89,6 +42,8 @@ if __name__ == '__main__':
                   help='maximum radix to search')
   ap.add_argument('minbandwidth', type=float,
                   help='minimum bisection bandwidth')
+  ap.add_argument('-c', '--cache', default='sf_bisection.cache',
+                  help='bisection cache file reused across runs')
   ap.add_argument('-v', '--verbose', default=False, action='store_true',
                   help='turn on verbose output')
   args = ap.parse_args()
@@ -29,21 +29,38 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
-#include <grid/Grid.h>
 #include <prim/prim.h>
 #include <strop/strop.h>
 #include <tclap/CmdLine.h>
 
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cmath>
 #include <deque>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "search/BisectionCache.h"
+#include "search/Bisector.h"
+#include "search/BisectorFactory.h"
 #include "search/Calculator.h"
 #include "search/CalculatorFactory.h"
 #include "search/Engine.h"
+#include "search/GraphExport.h"
+#include "search/HopCountCalculator.h"
+#include "search/ParetoFront.h"
+#include "search/QueryServer.h"
+#include "search/RadixSweep.h"
+#include "search/Resilience.h"
+#include "search/ResultWriter.h"
+#include "search/ResultWriterFactory.h"
+#include "search/SlimflyGraph.h"
+#include "search/WorkPool.h"
 
 s32 main(s32 _argc, char** _argv) {
   u64 minRadix;
@@ -56,6 +73,25 @@ s32 main(s32 _argc, char** _argv) {
   u64 maxResults;
   bool printSettings;
   std::string costCalc;
+  std::string bisection;
+  u64 seed;
+  u64 bisectionTrials;
+  std::string bisectionCacheFile;
+  u64 threads;
+  std::string format;
+  std::string stats;
+  std::string exportGraph;
+  std::string exportFormat;
+  bool serve;
+  std::string socketPath;
+  u64 sweepMinRadix = 0;
+  u64 sweepMaxRadix = 0;
+  std::string pareto;
+  bool hopCounts;
+  std::string resilience;
+  std::vector<f64> failures;
+  u64 resilienceTrials;
+  std::string resilienceFile;
 
   std::string version = "1.1";
   std::string description =
@@ -92,6 +128,68 @@ s32 main(s32 _argc, char** _argv) {
     TCLAP::ValueArg<std::string> costCalcArg(
         "", "costcalc", "cost calculator to use",
         false, "router_channel_count", "string", cmd);
+    TCLAP::ValueArg<std::string> bisectionArg(
+        "", "bisection", "bisection method to use (multilevel or spectral)",
+        false, "multilevel", "string", cmd);
+    TCLAP::ValueArg<u64> seedArg(
+        "", "seed", "random seed for the bisection method",
+        false, 1, "u64", cmd);
+    TCLAP::ValueArg<u64> bisectionTrialsArg(
+        "", "bisectiontrials", "number of seeded bisection trials per graph, "
+        "the smallest cut is kept",
+        false, 1, "u64", cmd);
+    TCLAP::ValueArg<std::string> bisectionCacheArg(
+        "", "bisectioncache", "file of bisection results shared across runs",
+        false, "", "string", cmd);
+    TCLAP::ValueArg<u64> threadsArg(
+        "", "threads", "number of threads used to compute bisections",
+        false, 1, "u64", cmd);
+    TCLAP::ValueArg<std::string> formatArg(
+        "", "format", "output format (table, csv, or jsonl)",
+        false, "table", "string", cmd);
+    TCLAP::ValueArg<std::string> sweepRadixArg(
+        "", "sweepradix", "report the largest network for each radix in "
+        "MIN:MAX as CSV instead of searching a terminal range",
+        false, "", "MIN:MAX", cmd);
+    TCLAP::ValueArg<std::string> paretoArg(
+        "", "pareto", "report the candidates no other one beats in all of "
+        "these comma separated objectives (routers, channels, radix, width, "
+        "cost, terminals, concentration, bisection) instead of the cheapest",
+        false, "", "string", cmd);
+    TCLAP::ValueArg<std::string> statsArg(
+        "", "stats", "print search statistics to stderr (text or json)",
+        false, "", "string", cmd);
+    TCLAP::ValueArg<std::string> exportGraphArg(
+        "", "exportgraph", "directory to write the router graph of every "
+        "result to",
+        false, "", "string", cmd);
+    TCLAP::ValueArg<std::string> exportFormatArg(
+        "", "exportformat", "graph export format (csr or metis)",
+        false, "csr", "string", cmd);
+    TCLAP::SwitchArg hopCountsArg(
+        "", "hopcounts", "report the diameter and average hop count of "
+        "every result's router graph",
+        cmd, false);
+    TCLAP::ValueArg<std::string> resilienceArg(
+        "", "resilience", "comma separated percentages of failed channels "
+        "to measure every result's router graph under (every trial rebuilds "
+        "the damaged graph and re-runs the sampled search, only the "
+        "bisection starts from the intact one)",
+        false, "", "string", cmd);
+    TCLAP::ValueArg<u64> resilienceTrialsArg(
+        "", "resiliencetrials", "number of random failure trials per "
+        "graph and percentage",
+        false, 1000, "u64", cmd);
+    TCLAP::ValueArg<std::string> resilienceFileArg(
+        "", "resiliencefile", "CSV file to write the failure analysis to",
+        false, "resilience.csv", "string", cmd);
+    TCLAP::SwitchArg serveArg(
+        "", "serve", "answer JSON line queries on stdin (or the socket) "
+        "with warm caches until closed",
+        cmd, false);
+    TCLAP::ValueArg<std::string> socketArg(
+        "", "socket", "Unix domain socket path used by serve mode",
+        false, "", "string", cmd);
     TCLAP::SwitchArg printSettingsArg(
         "p", "printsettings", "print the input settings",
         cmd, false);
@@ -107,12 +205,66 @@ s32 main(s32 _argc, char** _argv) {
     minTerminals = minTerminalsArg.getValue();
     maxTerminals = maxTerminalsArg.getValue();
     if (maxTerminals == 0) {
+      if (minTerminals > U64_MAX / 2) {
+        throw std::runtime_error("maxterminals must be given when "
+                                 "minterminals is too large to double");
+      }
       maxTerminals = minTerminals * 2;
     }
     minBandwidth = minBandwidthArg.getValue();
     maxResults = maxResultsArg.getValue();
     printSettings = printSettingsArg.getValue();
     costCalc = costCalcArg.getValue();
+    bisection = bisectionArg.getValue();
+    seed = seedArg.getValue();
+    bisectionTrials = bisectionTrialsArg.getValue();
+    if (bisectionTrials > U32_MAX) {
+      throw std::runtime_error("bisectiontrials must be at most " +
+                               std::to_string(U32_MAX));
+    }
+    bisectionCacheFile = bisectionCacheArg.getValue();
+    threads = threadsArg.getValue();
+    format = formatArg.getValue();
+    stats = statsArg.getValue();
+    if (!stats.empty() && stats != "text" && stats != "json") {
+      throw std::runtime_error("stats must be text or json");
+    }
+    exportGraph = exportGraphArg.getValue();
+    exportFormat = exportFormatArg.getValue();
+    if (exportFormat != "csr" && exportFormat != "metis") {
+      throw std::runtime_error("exportformat must be csr or metis");
+    }
+    hopCounts = hopCountsArg.getValue();
+    resilience = resilienceArg.getValue();
+    if (!resilience.empty()) {
+      failures = Resilience::parseFailures(resilience);
+    }
+    resilienceTrials = resilienceTrialsArg.getValue();
+    if (resilienceTrials < 1) {
+      throw std::runtime_error("resiliencetrials must be at least 1");
+    }
+    resilienceFile = resilienceFileArg.getValue();
+    serve = serveArg.getValue();
+    socketPath = socketArg.getValue();
+
+    // a radix sweep searches every network size up to the largest radix
+    std::string sweepRadix = sweepRadixArg.getValue();
+    if (!sweepRadix.empty()) {
+      char extra;
+      if ((sscanf(sweepRadix.c_str(), "%lu:%lu%c", &sweepMinRadix,
+                  &sweepMaxRadix, &extra) != 2) ||
+          (sweepMinRadix > sweepMaxRadix) || (sweepMaxRadix < minRadix)) {
+        throw std::runtime_error("sweepradix must be MIN:MAX with "
+                                 "minradix <= MAX and MIN <= MAX");
+      }
+      maxRadix = sweepMaxRadix;
+      minTerminals = minRadix;
+      maxTerminals = U64_MAX;
+    }
+    pareto = paretoArg.getValue();
+    if (!pareto.empty() && !sweepRadix.empty()) {
+      throw std::runtime_error("pareto and sweepradix can't be combined");
+    }
   } catch (TCLAP::ArgException& e) {
     throw std::runtime_error(e.error().c_str());
   }
@@ -129,6 +281,23 @@ s32 main(s32 _argc, char** _argv) {
            "  minBandwidth = %f\n"
            "  maxResults = %lu\n"
            "  costCalc = %s\n"
+           "  bisection = %s\n"
+           "  seed = %lu\n"
+           "  bisectionTrials = %lu\n"
+           "  bisectionCache = %s\n"
+           "  threads = %lu\n"
+           "  format = %s\n"
+           "  sweepRadix = %lu:%lu\n"
+           "  pareto = %s\n"
+           "  hopCounts = %s\n"
+           "  resilience = %s\n"
+           "  resilienceTrials = %lu\n"
+           "  resilienceFile = %s\n"
+           "  stats = %s\n"
+           "  exportGraph = %s\n"
+           "  exportFormat = %s\n"
+           "  serve = %s\n"
+           "  socket = %s\n"
            "\n",
            minRadix,
            maxRadix,
@@ -138,75 +307,168 @@ s32 main(s32 _argc, char** _argv) {
            maxTerminals,
            minBandwidth,
            maxResults,
-           costCalc.c_str());
+           costCalc.c_str(),
+           bisection.c_str(),
+           seed,
+           bisectionTrials,
+           bisectionCacheFile.c_str(),
+           threads,
+           format.c_str(),
+           sweepMinRadix,
+           sweepMaxRadix,
+           pareto.c_str(),
+           hopCounts ? "true" : "false",
+           resilience.c_str(),
+           resilienceTrials,
+           resilienceFile.c_str(),
+           stats.c_str(),
+           exportGraph.c_str(),
+           exportFormat.c_str(),
+           serve ? "true" : "false",
+           socketPath.c_str());
   }
 
   // create the cost calculator
   Calculator* calc = CalculatorFactory::createCalculator(costCalc);
 
+  // create the bisection method
+  Bisector* bisector = BisectorFactory::createBisector(bisection, seed);
+
+  // create the bisection cache, loading previous results if given a file
+  BisectionCache bisectionCache;
+  if (!bisectionCacheFile.empty()) {
+    bisectionCache.open(bisectionCacheFile);
+  }
+
+  // create the thread pool
+  WorkPool workPool(threads);
+
+  // in serve mode the caches above stay warm across all queries
+  if (serve) {
+    SearchQuery defaults = {
+      minRadix, maxRadix, minConcentration, maxConcentration, minTerminals,
+      maxTerminals, minBandwidth, maxResults, costCalc, bisectionTrials};
+    QueryServer server(defaults, bisector, &bisectionCache, &workPool);
+    if (socketPath.empty()) {
+      server.serve(stdin, stdout);
+    } else {
+      server.listen(socketPath);
+    }
+    delete bisector;
+    delete calc;
+    return 0;
+  }
+
+  // add the diameter and average hop count to the printed results
+  HopCountCalculator* hopCountCalc = nullptr;
+  if (hopCounts) {
+    hopCountCalc = new HopCountCalculator(calc, &workPool);
+  }
+  const Calculator* outputCalc = hopCountCalc ? hopCountCalc : calc;
+
+  // create the result writer, or the sweep that replaces it. the pareto
+  //  front replaces the writer as listener, the writer prints the front.
+  ResultWriter* writer = nullptr;
+  RadixSweep* sweep = nullptr;
+  ParetoFront* front = nullptr;
+  if (sweepMaxRadix > 0) {
+    sweep = new RadixSweep(sweepMinRadix, sweepMaxRadix);
+  } else {
+    writer = ResultWriterFactory::createResultWriter(format, outputCalc,
+                                                     stdout);
+  }
+  if (!pareto.empty()) {
+    front = new ParetoFront(pareto);
+  }
+
   // create and run the engine
   Engine engine(
       minRadix, maxRadix, minConcentration, maxConcentration,
-      minTerminals, maxTerminals, minBandwidth, maxResults, calc);
+      minTerminals, maxTerminals, minBandwidth, maxResults, calc, bisector,
+      bisectionTrials, &bisectionCache, &workPool);
+  if (sweep) {
+    engine.addListener(sweep);
+  } else if (front) {
+    engine.addListener(front);
+  } else {
+    engine.addListener(writer);
+  }
   engine.run();
+  if (stats == "text") {
+    fprintf(stderr, "%s", engine.stats().text().c_str());
+  } else if (stats == "json") {
+    fprintf(stderr, "%s\n", engine.stats().json().c_str());
+  }
 
-  // gather the results
-  const std::deque<Slimfly>& results = engine.results();
-
-  // create the output grid
-  const std::vector<std::string>& extFields = calc->extFields();
-  grid::Grid grid(1 + results.size(), 11 + extFields.size());
-
-  // format the regular header
-  grid.set(0, 0, "#");
-  grid.set(0, 1, "Dimensions");
-  grid.set(0, 2, "Width");
-  grid.set(0, 3, "Concentration");
-  grid.set(0, 4, "Terminals");
-  grid.set(0, 5, "Routers");
-  grid.set(0, 6, "Radix");
-  grid.set(0, 7, "Channels");
-  grid.set(0, 8, "Bisection");
-  grid.set(0, 9, "Cost");
-
-  // format the extension header
-  for (u64 ext = 0; ext < extFields.size(); ext++) {
-    grid.set(0, 11 + ext, extFields.at(ext));
+  // print the final results
+  std::deque<Slimfly> results =
+      front ? front->frontier() : engine.results();
+  if (sweep) {
+    sweep->write(stdout);
+  } else {
+    writer->finish(results);
   }
 
-  // format the data section
-  for (u64 idx = 0; idx < results.size(); idx++) {
-    u64 row = idx + 1;
-
-    // get the results
-    const Slimfly& res = results.at(idx);
-
-    // format the regular values in the row
-    grid.set(row, 0, std::to_string(row));
-    grid.set(row, 1, std::to_string(res.dimensions));
-    grid.set(row, 2, std::to_string(res.width));
-    grid.set(row, 3, std::to_string(res.concentration));
-    grid.set(row, 4, std::to_string(res.terminals));
-    grid.set(row, 5, std::to_string(res.routers));
-    grid.set(row, 6, std::to_string(res.routerRadix));
-    grid.set(row, 7, std::to_string(res.channels));
-    grid.set(row, 8, std::to_string(res.bisections));
-    grid.set(row, 9, std::to_string(res.cost));
-
-    // get extension values from the calculator
-    const std::unordered_map<std::string, std::string>& extValues =
-        calc->extValues(res);
-
-    // format the extensions values in the row
-    for (u64 ext = 0; ext < extFields.size(); ext++) {
-      grid.set(row, 11 + ext, extValues.at(extFields.at(ext)));
+  // write the router graph of every result, results often share a width
+  if (!exportGraph.empty()) {
+    if (mkdir(exportGraph.c_str(), 0755) != 0 && errno != EEXIST) {
+      throw std::runtime_error("unable to create directory: " + exportGraph);
+    }
+    std::set<u64> widths;
+    for (const Slimfly& result : results) {
+      if (!widths.insert(result.width).second) {
+        continue;
+      }
+      SlimflyGraph graph(result.width,
+                         SlimflyGraph::deltaOf(result.width));
+      std::string path = exportGraph + "/slimfly_" +
+          std::to_string(result.width);
+      if (exportFormat == "csr") {
+        GraphExport::writeBinary(graph, path + ".csr");
+      } else {
+        GraphExport::writeMetis(graph, path + ".graph");
+      }
     }
   }
 
-  // print the output grid
-  printf("%s", grid.toString().c_str());
+  // measure every result's router graph under random channel failures,
+  //  the graph and its intact bisection are shared by results of a width
+  if (!failures.empty()) {
+    FILE* out = fopen(resilienceFile.c_str(), "w");
+    if (!out) {
+      throw std::runtime_error("unable to open file: " + resilienceFile);
+    }
+    Resilience::writeHeader(out);
+    Resilience analysis(bisector, &workPool, resilienceTrials, seed);
+    std::set<u64> widths;
+    for (const Slimfly& result : results) {
+      if (!widths.insert(result.width).second) {
+        continue;
+      }
+      SlimflyGraph graph(result.width,
+                         SlimflyGraph::deltaOf(result.width));
+      std::vector<u8> where;
+      analysis.split(graph, &where);
+      for (f64 failure : failures) {
+        std::vector<Resilience::Trial> trials =
+            analysis.run(graph, where, failure);
+        for (u64 idx = 0; idx < results.size(); idx++) {
+          if (results[idx].width == result.width) {
+            Resilience::writeRows(out, idx + 1, results[idx], failure,
+                                  trials);
+          }
+        }
+      }
+    }
+    fclose(out);
+  }
 
   // cleanup
+  delete front;
+  delete sweep;
+  delete writer;
+  delete hopCountCalc;
+  delete bisector;
   delete calc;
 
   return 0;
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/BisectionBounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "search/GaloisField.h"
+#include "search/util.h"
+
+// guards the spectral bound against floating point round off
+static const f64 kEpsilon = 1e-6;
+
+f64 algebraicConnectivity(u32 _width, s32 _delta) {
+  const GaloisField& field = *GaloisField::get(_width);
+  u32 q = field.order();
+  u32 p = field.characteristic();
+  std::vector<u32> X, X_i;
+  createGeneratorSet(field, _delta, X, X_i);
+
+  // absolute trace Tr(z) = z + z^p + ... + z^(p^(k-1)) of every element
+  std::vector<u32> trace(q, 0);
+  for (u32 z = 1; z < q; z++) {
+    u32 sum = 0;
+    u64 exponent = field.log(z);
+    for (u32 i = 0; i < field.degree(); i++) {
+      sum = field.add(sum, field.exp(exponent));
+      exponent = exponent * p % (q - 1);
+    }
+    trace[z] = sum;
+  }
+
+  /*
+   * For the additive character psi_t, the adjacency matrix restricted to
+   * functions a_x psi_t(y) and b_m psi_t(c) is [[A I, F], [F*, B I]] with
+   * A = sum psi_t(X), B = sum psi_t(X') and F F* = q I for t != 0. Its
+   * eigenvalues are (A+B)/2 +- sqrt(((A-B)/2)^2 + q). For t = 0 the
+   * eigenvalues are |X|, |X'| and the pair containing the degree.
+   */
+  f64 degree = X.size() + q;
+  f64 second = std::max<f64>(X.size(), X_i.size());
+  second = std::max(second, (X.size() + X_i.size()) / 2.0 -
+                    std::sqrt(std::pow((X.size() - X_i.size()) / 2.0, 2) +
+                              static_cast<f64>(q) * q));
+  for (u32 t = 1; t < q; t++) {
+    f64 a = 0;
+    f64 b = 0;
+    for (u32 s : X) {
+      a += std::cos(2 * M_PI * trace[field.mul(t, s)] / p);
+    }
+    for (u32 s : X_i) {
+      b += std::cos(2 * M_PI * trace[field.mul(t, s)] / p);
+    }
+    f64 eigen = (a + b) / 2 + std::sqrt(std::pow((a - b) / 2, 2) + q);
+    second = std::max(second, eigen);
+  }
+  return degree - second;
+}
+
+BisectionBounds computeBisectionBounds(u32 _width, s32 _delta,
+                                       f64 _imbalance) {
+  u64 q = _width;
+  u64 routers = 2 * q * q;
+  BisectionBounds bounds;
+
+  // the smallest part the bisector is allowed to produce
+  u64 maxPart = static_cast<u64>(std::ceil((routers / 2.0) * _imbalance));
+  u64 minPart = (maxPart >= routers) ? 0 : routers - maxPart;
+  f64 lower = algebraicConnectivity(_width, _delta) *
+      minPart * (routers - minPart) / routers;
+  bounds.lower = (lower > kEpsilon) ?
+      static_cast<u64>(std::ceil(lower - kEpsilon)) : 0;
+
+  // h0 columns of subgraph 0 with h1 columns of subgraph 1, h0 + h1 = q
+  u64 h0 = (q + 1) / 2;
+  u64 h1 = q - h0;
+  bounds.upper = q * (h0 * (q - h1) + (q - h0) * h1);
+  return bounds;
+}
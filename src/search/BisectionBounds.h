@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_BISECTIONBOUNDS_H_
+#define SEARCH_BISECTIONBOUNDS_H_
+
+#include <prim/prim.h>
+
+/*
+ * Cheap bounds on the edge cut of a balanced bisection of a Slim Fly router
+ * graph, computed without building the graph.
+ *
+ * The lower bound is spectral: every partition into parts of s and n-s
+ * routers cuts at least a2 * s * (n - s) / n channels, where a2 is the
+ * algebraic connectivity (second smallest Laplacian eigenvalue). The MMS
+ * graph spectrum is known in closed form from the additive characters of
+ * GF(q). The bound is taken at the most unbalanced partition the bisector
+ * may return.
+ *
+ * The upper bound is the cut of an explicit balanced partition: (q+1)/2
+ * columns of subgraph 0 against (q-1)/2 columns of subgraph 1. It only cuts
+ * inter subgraph channels, exactly q per pair of columns.
+ */
+struct BisectionBounds {
+  u64 lower;
+  u64 upper;
+};
+
+// the algebraic connectivity of the Slim Fly router graph
+f64 algebraicConnectivity(u32 _width, s32 _delta);
+
+BisectionBounds computeBisectionBounds(u32 _width, s32 _delta,
+                                       f64 _imbalance);
+
+#endif  // SEARCH_BISECTIONBOUNDS_H_
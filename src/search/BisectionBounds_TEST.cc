@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/BisectionBounds.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "search/MultilevelBisector.h"
+#include "search/SlimflyGraph.h"
+#include "search/util.h"
+
+// all eigenvalues of a dense symmetric matrix by cyclic Jacobi rotations
+static std::vector<f64> eigenvalues(std::vector<std::vector<f64> > _matrix) {
+  u32 n = _matrix.size();
+  for (u32 sweep = 0; sweep < 100; sweep++) {
+    f64 off = 0;
+    for (u32 i = 0; i < n; i++) {
+      for (u32 j = i + 1; j < n; j++) {
+        off += _matrix[i][j] * _matrix[i][j];
+      }
+    }
+    if (off < 1e-20) {
+      break;
+    }
+    for (u32 p = 0; p < n; p++) {
+      for (u32 q = p + 1; q < n; q++) {
+        if (std::fabs(_matrix[p][q]) < 1e-300) {
+          continue;
+        }
+        f64 theta = (_matrix[q][q] - _matrix[p][p]) / (2 * _matrix[p][q]);
+        f64 t = ((theta >= 0) ? 1.0 : -1.0) /
+            (std::fabs(theta) + std::sqrt(theta * theta + 1));
+        f64 c = 1 / std::sqrt(t * t + 1);
+        f64 s = t * c;
+        for (u32 k = 0; k < n; k++) {
+          f64 kp = _matrix[k][p];
+          f64 kq = _matrix[k][q];
+          _matrix[k][p] = c * kp - s * kq;
+          _matrix[k][q] = s * kp + c * kq;
+        }
+        for (u32 k = 0; k < n; k++) {
+          f64 pk = _matrix[p][k];
+          f64 qk = _matrix[q][k];
+          _matrix[p][k] = c * pk - s * qk;
+          _matrix[q][k] = s * pk + c * qk;
+        }
+      }
+    }
+  }
+  std::vector<f64> values(n);
+  for (u32 i = 0; i < n; i++) {
+    values[i] = _matrix[i][i];
+  }
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+TEST(BisectionBounds, algebraicConnectivity) {
+  // the closed form matches a dense eigen solve of the Laplacian
+  for (u32 width : primePowers(4, 9)) {
+    s32 delta = SlimflyGraph::deltaOf(width);
+    SlimflyGraph graph(width, delta);
+    u32 n = graph.numNodes();
+    std::vector<std::vector<f64> > laplacian(n, std::vector<f64>(n, 0));
+    for (u32 node = 0; node < n; node++) {
+      laplacian[node][node] = graph.degree(node);
+      for (u32 e = graph.offsets()[node]; e < graph.offsets()[node + 1];
+           e++) {
+        laplacian[node][graph.neighbors()[e]] -= 1;
+      }
+    }
+    std::vector<f64> values = eigenvalues(laplacian);
+    EXPECT_NEAR(values[0], 0.0, 1e-6);
+    EXPECT_NEAR(algebraicConnectivity(width, delta), values[1], 1e-6)
+        << "width " << width;
+  }
+}
+
+TEST(BisectionBounds, explicitPartition) {
+  // the upper bound is the cut of (q+1)/2 columns of subgraph 0 with
+  //  (q-1)/2 columns of subgraph 1
+  for (u32 q : primePowers(4, 27)) {
+    s32 delta = SlimflyGraph::deltaOf(q);
+    SlimflyGraph graph(q, delta);
+    std::vector<u8> where(graph.numNodes(), 1);
+    for (u32 col = 0; col < q; col++) {
+      for (u32 row = 0; row < q; row++) {
+        if (col < (q + 1) / 2) {
+          where[SlimflyGraph::routerId(0, col, row, q)] = 0;
+        }
+        if (col < (q - 1) / 2) {
+          where[SlimflyGraph::routerId(1, col, row, q)] = 0;
+        }
+      }
+    }
+    BisectionBounds bounds = computeBisectionBounds(q, delta, 1.0);
+    EXPECT_EQ(Bisector::countCut(graph.offsets(), graph.neighbors(), where),
+              bounds.upper) << "width " << q;
+  }
+}
+
+TEST(BisectionBounds, multilevelCut) {
+  // every cut the bisector finds is within the bounds, the best of a few
+  //  trials is no worse than the explicit partition
+  MultilevelBisector bisector(12345);
+  for (u32 width : primePowers(4, 27)) {
+    s32 delta = SlimflyGraph::deltaOf(width);
+    SlimflyGraph graph(width, delta);
+    BisectionBounds bounds = computeBisectionBounds(width, delta,
+                                                    bisector.imbalance());
+    EXPECT_LE(bounds.lower, bounds.upper);
+    u64 best = U64_MAX;
+    for (u64 trial = 0; trial < 4; trial++) {
+      u64 cut = bisector.edgeCut(graph.offsets(), graph.neighbors(), trial);
+      EXPECT_LE(bounds.lower, cut) << "width " << width;
+      best = std::min(best, cut);
+    }
+    EXPECT_LE(best, bounds.upper) << "width " << width;
+  }
+}
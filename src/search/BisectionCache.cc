@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/BisectionCache.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+static const char kMagic[8] = {'S', 'F', 'B', 'C', 'A', 'C', 'H', 'E'};
+static const u64 kVersion = 2;
+static const u64 kHeaderSize = sizeof(kMagic) + sizeof(kVersion);
+
+BisectionCache::BisectionCache()
+    : fd_(-1) {}
+
+BisectionCache::~BisectionCache() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+void BisectionCache::open(const std::string& _path) {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+  fd_ = ::open(_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (fd_ < 0) {
+    throw std::runtime_error("unable to open bisection cache: " + _path);
+  }
+
+  /* Processes opening a new file at the same time must not both write the
+   * header, so the size is checked and the header written under a lock.
+   * Whoever takes the lock second sees the header and reads the file.
+   */
+  if (flock(fd_, LOCK_EX) != 0) {
+    throw std::runtime_error("unable to lock bisection cache: " + _path);
+  }
+  struct stat info;
+  bool ok = fstat(fd_, &info) == 0;
+  u64 length = ok ? info.st_size : 0;
+  bool created = ok && length == 0;
+  if (created) {
+    char header[kHeaderSize];
+    memcpy(header, kMagic, sizeof(kMagic));
+    memcpy(header + sizeof(kMagic), &kVersion, sizeof(kVersion));
+    ok = write(fd_, header, kHeaderSize) == static_cast<ssize_t>(kHeaderSize);
+  }
+  flock(fd_, LOCK_UN);
+  if (!ok) {
+    throw std::runtime_error("unable to initialize bisection cache: " + _path);
+  }
+
+  // a new file only has the header
+  if (created) {
+    return;
+  }
+
+  // map the existing file and read every complete record
+  void* base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (base == MAP_FAILED) {
+    throw std::runtime_error("unable to map bisection cache: " + _path);
+  }
+  const char* bytes = static_cast<const char*>(base);
+  u64 version = 0;
+  if (length >= kHeaderSize) {
+    memcpy(&version, bytes + sizeof(kMagic), sizeof(version));
+  }
+  if (length < kHeaderSize || memcmp(bytes, kMagic, sizeof(kMagic)) != 0) {
+    munmap(base, length);
+    throw std::runtime_error("not a bisection cache file: " + _path);
+  }
+  if (version != kVersion) {
+    munmap(base, length);
+    throw std::runtime_error("bisection cache was written by another "
+                             "version, remove it: " + _path);
+  }
+  u64 count = (length - kHeaderSize) / sizeof(Record);
+  const Record* records =
+      reinterpret_cast<const Record*>(bytes + kHeaderSize);
+  entries_.reserve(entries_.size() + count);
+  for (u64 idx = 0; idx < count; idx++) {
+    Key key = {records[idx].width, records[idx].delta,
+               records[idx].settings};
+    merge(key, records[idx].edgeCut, records[idx].exact != 0);
+  }
+  munmap(base, length);
+}
+
+bool BisectionCache::lookup(u32 _width, s32 _delta, u64 _settings,
+                            u64* _edgeCut, bool* _exact) const {
+  Key key = {_width, _delta, _settings};
+  std::unordered_map<Key, Entry, KeyHash>::const_iterator it =
+      entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  *_edgeCut = it->second.edgeCut;
+  *_exact = it->second.exact;
+  return true;
+}
+
+void BisectionCache::insert(u32 _width, s32 _delta, u64 _settings,
+                            u64 _edgeCut, bool _exact) {
+  Key key = {_width, _delta, _settings};
+  if (!merge(key, _edgeCut, _exact)) {
+    return;
+  }
+
+  if (fd_ >= 0) {
+    Record record = {_width, _delta, _settings, _edgeCut,
+                     _exact ? 1u : 0u, 0};
+    if (write(fd_, &record, sizeof(record)) !=
+        static_cast<ssize_t>(sizeof(record))) {
+      throw std::runtime_error("unable to append to bisection cache");
+    }
+  }
+}
+
+u64 BisectionCache::size() const {
+  return entries_.size();
+}
+
+void BisectionCache::clear() {
+  entries_.clear();
+}
+
+bool BisectionCache::merge(const Key& _key, u64 _edgeCut, bool _exact) {
+  std::unordered_map<Key, Entry, KeyHash>::iterator it = entries_.find(_key);
+  if (it != entries_.end()) {
+    Entry& entry = it->second;
+    if (entry.exact && !_exact) {
+      return false;
+    }
+    if (entry.exact == _exact && entry.edgeCut <= _edgeCut) {
+      return false;
+    }
+  }
+  Entry entry = {_edgeCut, _exact};
+  entries_[_key] = entry;
+  return true;
+}
+
+u64 BisectionCache::settingsKey(const std::string& _settings) {
+  // 64-bit FNV-1a, stable across runs and platforms
+  u64 hash = 0xcbf29ce484222325ull;
+  for (char c : _settings) {
+    hash ^= static_cast<u8>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+bool BisectionCache::Key::operator==(const Key& _other) const {
+  return width == _other.width && delta == _other.delta &&
+      settings == _other.settings;
+}
+
+size_t BisectionCache::KeyHash::operator()(const Key& _key) const {
+  u64 hash = _key.settings;
+  hash ^= (static_cast<u64>(_key.width) << 32) ^
+      static_cast<u32>(_key.delta);
+  hash *= 0x9e3779b97f4a7c15ull;
+  return static_cast<size_t>(hash ^ (hash >> 32));
+}
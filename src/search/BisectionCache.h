@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_BISECTIONCACHE_H_
+#define SEARCH_BISECTIONCACHE_H_
+
+#include <prim/prim.h>
+
+#include <string>
+#include <unordered_map>
+
+/*
+ * The router graph only depends on the width and delta, so its bisection
+ * edge cut can be reused for every concentration of that width. Entries are
+ * keyed by (width, delta, bisector settings). An entry is exact when every
+ * configured trial ran; a search that stopped early only knows an upper bound
+ * on what the full set of trials would find. Exact entries replace inexact
+ * ones, never the other way around.
+ *
+ * The cache can optionally be backed by a file so that results are shared
+ * across invocations. The file is a small header followed by fixed size
+ * records. It is memory mapped when opened and new entries are appended with
+ * a single write each, so concurrent processes may share one file.
+ */
+class BisectionCache {
+ public:
+  BisectionCache();
+  ~BisectionCache();
+
+  // loads all entries from the file and appends new entries to it
+  void open(const std::string& _path);
+
+  bool lookup(u32 _width, s32 _delta, u64 _settings, u64* _edgeCut,
+              bool* _exact) const;
+  void insert(u32 _width, s32 _delta, u64 _settings, u64 _edgeCut,
+              bool _exact);
+  u64 size() const;
+  void clear();
+
+  // reduces a Bisector settings string to the key used by the cache
+  static u64 settingsKey(const std::string& _settings);
+
+ private:
+  struct Key {
+    u32 width;
+    s32 delta;
+    u64 settings;
+    bool operator==(const Key& _other) const;
+  };
+  struct KeyHash {
+    size_t operator()(const Key& _key) const;
+  };
+
+  struct Entry {
+    u64 edgeCut;
+    bool exact;
+  };
+
+  struct Record {
+    u32 width;
+    s32 delta;
+    u64 settings;
+    u64 edgeCut;
+    u32 exact;
+    u32 reserved;
+  };
+
+  // keeps the better of the current and the given entry, true if it changed
+  bool merge(const Key& _key, u64 _edgeCut, bool _exact);
+
+  std::unordered_map<Key, Entry, KeyHash> entries_;
+  s32 fd_;
+};
+
+#endif  // SEARCH_BISECTIONCACHE_H_
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/BisectionCache.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+static std::string cachePath(const std::string& _name) {
+  std::string path = ::testing::TempDir() + "/" + _name + "_" +
+      std::to_string(getpid()) + ".sfbc";
+  unlink(path.c_str());
+  return path;
+}
+
+TEST(BisectionCache, merge) {
+  BisectionCache cache;
+  u64 edgeCut;
+  bool exact;
+  EXPECT_FALSE(cache.lookup(23, -1, 7, &edgeCut, &exact));
+
+  // smaller inexact cuts replace larger ones
+  cache.insert(23, -1, 7, 100, false);
+  cache.insert(23, -1, 7, 90, false);
+  cache.insert(23, -1, 7, 95, false);
+  ASSERT_TRUE(cache.lookup(23, -1, 7, &edgeCut, &exact));
+  EXPECT_EQ(edgeCut, 90u);
+  EXPECT_FALSE(exact);
+
+  // an exact cut replaces any inexact one, never the other way around
+  cache.insert(23, -1, 7, 120, true);
+  cache.insert(23, -1, 7, 80, false);
+  ASSERT_TRUE(cache.lookup(23, -1, 7, &edgeCut, &exact));
+  EXPECT_EQ(edgeCut, 120u);
+  EXPECT_TRUE(exact);
+
+  // keys differ by width, delta and settings
+  EXPECT_FALSE(cache.lookup(23, 1, 7, &edgeCut, &exact));
+  EXPECT_FALSE(cache.lookup(23, -1, 8, &edgeCut, &exact));
+  EXPECT_EQ(cache.size(), 1u);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(BisectionCache, reopen) {
+  std::string path = cachePath("reopen");
+  u64 settings = BisectionCache::settingsKey("multilevel seed=12345");
+  {
+    BisectionCache cache;
+    cache.open(path);
+    cache.insert(23, -1, settings, 6095, true);
+    cache.insert(25, 1, settings, 8000, false);
+    cache.insert(25, 1, settings, 7900, false);
+    cache.insert(27, -1, settings, 9900, false);
+    cache.insert(27, -1, settings, 9855, true);
+  }
+
+  BisectionCache cache;
+  cache.open(path);
+  EXPECT_EQ(cache.size(), 3u);
+  u64 edgeCut;
+  bool exact;
+  ASSERT_TRUE(cache.lookup(23, -1, settings, &edgeCut, &exact));
+  EXPECT_EQ(edgeCut, 6095u);
+  EXPECT_TRUE(exact);
+  ASSERT_TRUE(cache.lookup(25, 1, settings, &edgeCut, &exact));
+  EXPECT_EQ(edgeCut, 7900u);
+  EXPECT_FALSE(exact);
+  ASSERT_TRUE(cache.lookup(27, -1, settings, &edgeCut, &exact));
+  EXPECT_EQ(edgeCut, 9855u);
+  EXPECT_TRUE(exact);
+  unlink(path.c_str());
+}
+
+TEST(BisectionCache, shared) {
+  // both open the new file before either writes, only one header is written
+  std::string path = cachePath("shared");
+  BisectionCache first;
+  BisectionCache second;
+  first.open(path);
+  second.open(path);
+  first.insert(23, -1, 1, 6095, true);
+  second.insert(25, 1, 1, 7825, true);
+
+  BisectionCache cache;
+  cache.open(path);
+  EXPECT_EQ(cache.size(), 2u);
+  u64 edgeCut;
+  bool exact;
+  ASSERT_TRUE(cache.lookup(23, -1, 1, &edgeCut, &exact));
+  EXPECT_EQ(edgeCut, 6095u);
+  ASSERT_TRUE(cache.lookup(25, 1, 1, &edgeCut, &exact));
+  EXPECT_EQ(edgeCut, 7825u);
+  unlink(path.c_str());
+}
+
+TEST(BisectionCache, notACache) {
+  std::string path = cachePath("bad");
+  FILE* file = fopen(path.c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  fprintf(file, "this is not a bisection cache\n");
+  fclose(file);
+
+  BisectionCache cache;
+  EXPECT_THROW(cache.open(path), std::runtime_error);
+  unlink(path.c_str());
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/Bisector.h"
+
+Bisector::Bisector() {}
+
+Bisector::~Bisector() {}
+
+Bisector::Decision Bisector::cutBelow(const std::vector<u32>& _offsets,
+                                      const std::vector<u32>& _neighbors,
+                                      u64 _trial, u64 _threshold) const {
+  (void)_threshold;  // unused
+  Decision decision = {edgeCut(_offsets, _neighbors, _trial), true};
+  return decision;
+}
+
+u64 Bisector::refinePartition(const std::vector<u32>& _offsets,
+                              const std::vector<u32>& _neighbors,
+                              std::vector<u8>* _where) const {
+  return countCut(_offsets, _neighbors, *_where);
+}
+
+f64 Bisector::imbalance() const {
+  return 1.0;
+}
+
+u64 Bisector::trialSeed(u64 _seed, u64 _trial) {
+  // spread the trials apart with a 64-bit golden ratio step
+  return _seed ^ (_trial * 0x9E3779B97F4A7C15lu);
+}
+
+u64 Bisector::countCut(const std::vector<u32>& _offsets,
+                       const std::vector<u32>& _neighbors,
+                       const std::vector<u8>& _where) {
+  u64 cut = 0;
+  for (u32 v = 0; v + 1 < _offsets.size(); v++) {
+    for (u32 e = _offsets[v]; e < _offsets[v + 1]; e++) {
+      cut += _where[v] != _where[_neighbors[e]];
+    }
+  }
+  return cut / 2;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_BISECTOR_H_
+#define SEARCH_BISECTOR_H_
+
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+/*
+ * A Bisector splits an undirected graph into two balanced halves and reports
+ * the number of edges that cross between them. Graphs are given in compressed
+ * sparse row form using the same layout as the METIS xadj/adjncy arrays
+ * (0-based, every edge present in both directions). settings() describes
+ * everything that can change the result (method, seed, ...) and is used to
+ * key cached results. imbalance() is the largest allowed part size relative to
+ * an exact half (1.0 means exactly balanced). Randomized methods draw a
+ * different but reproducible seed for every _trial, trial 0 uses the
+ * configured seed itself.
+ *
+ * cutBelow() is the decision mode used when only "is the cut below X" matters.
+ * It may return as soon as it holds a balanced cut smaller than _threshold.
+ * The decision is then not complete and its cut is only an upper bound on
+ * what edgeCut() would return. Otherwise it runs to the end and returns the
+ * same cut as edgeCut(). Methods without an early exit simply run edgeCut().
+ *
+ * split() is edgeCut() that also returns the part (0 or 1) of every vertex.
+ * refinePartition() improves a given partition in place with local moves
+ * only and returns its cut. It lets a nearby graph (e.g. the same graph with
+ * some edges removed) start from a known good partition instead of being
+ * bisected from scratch. Methods without local moves just count the cut.
+ */
+class Bisector {
+ public:
+  struct Decision {
+    u64 edgeCut;
+    bool complete;
+  };
+
+  Bisector();
+  virtual ~Bisector();
+  virtual u64 edgeCut(const std::vector<u32>& _offsets,
+                      const std::vector<u32>& _neighbors,
+                      u64 _trial) const = 0;
+  virtual Decision cutBelow(const std::vector<u32>& _offsets,
+                            const std::vector<u32>& _neighbors, u64 _trial,
+                            u64 _threshold) const;
+  virtual u64 split(const std::vector<u32>& _offsets,
+                    const std::vector<u32>& _neighbors, u64 _trial,
+                    std::vector<u8>* _where) const = 0;
+  virtual u64 refinePartition(const std::vector<u32>& _offsets,
+                              const std::vector<u32>& _neighbors,
+                              std::vector<u8>* _where) const;
+  virtual std::string settings() const = 0;
+  virtual f64 imbalance() const;
+
+  // the number of edges that cross the partition _where
+  static u64 countCut(const std::vector<u32>& _offsets,
+                      const std::vector<u32>& _neighbors,
+                      const std::vector<u8>& _where);
+
+ protected:
+  static u64 trialSeed(u64 _seed, u64 _trial);
+};
+
+#endif  // SEARCH_BISECTOR_H_
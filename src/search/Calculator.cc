@@ -48,3 +48,16 @@ std::unordered_map<std::string, std::string> Calculator::extValues(
   (void)_slimfly;  // unused
   return EMPTY_VALUES;
 }
+
+void Calculator::fillExtValues(const Slimfly& _slimfly,
+                               std::vector<std::string>* _values) const {
+  const std::vector<std::string>& fields = extFields();
+  _values->resize(fields.size());
+  if (fields.empty()) {
+    return;
+  }
+  std::unordered_map<std::string, std::string> values = extValues(_slimfly);
+  for (u64 ext = 0; ext < fields.size(); ext++) {
+    (*_values)[ext].swap(values.at(fields.at(ext)));
+  }
+}
@@ -50,6 +50,11 @@ class Calculator : public CostFunction {
   virtual std::unordered_map<std::string, std::string> extValues(
       const Slimfly& _slimfly) const;
 
+  // fills _values with the ext values in extFields() order, reusing its
+  //  storage across rows. the default goes through extValues().
+  virtual void fillExtValues(const Slimfly& _slimfly,
+                             std::vector<std::string>* _values) const;
+
  private:
   static const std::vector<std::string> EMPTY_FIELDS;
   static const std::unordered_map<std::string, std::string> EMPTY_VALUES;
@@ -36,10 +36,18 @@
 #include "search/RouterChannelCount.h"
 
 Calculator* CalculatorFactory::createCalculator(const std::string& _type) {
+  Calculator* calc = tryCreateCalculator(_type);
+  if (calc == nullptr) {
+    fprintf(stderr, "unknown cost calculator: %s\n", _type.c_str());
+    exit(-1);
+  }
+  return calc;
+}
+
+Calculator* CalculatorFactory::tryCreateCalculator(const std::string& _type) {
   if (_type == "router_channel_count") {
     return new RouterChannelCount();
   } else {
-    fprintf(stderr, "unknown cost calculator: %s\n", _type.c_str());
-    exit(-1);
+    return nullptr;
   }
 }
@@ -39,6 +39,8 @@
 class CalculatorFactory {
  public:
   static Calculator* createCalculator(const std::string& _type);
+  // returns nullptr for unknown types instead of exiting
+  static Calculator* tryCreateCalculator(const std::string& _type);
 };
 
 #endif  // SEARCH_CALCULATORFACTORY_H_
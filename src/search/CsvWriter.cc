@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/CsvWriter.h"
+
+#include <vector>
+
+CsvWriter::CsvWriter(const Calculator* _calc, FILE* _out)
+    : ResultWriter(_calc, _out) {
+  std::string header = "record,rank,dimensions,width,concentration,"
+      "terminals,routers,radix,channels,bisection,cost";
+  for (const std::string& field : calc_->extFields()) {
+    header += "," + quote(field);
+  }
+  fprintf(out_, "%s\n", header.c_str());
+  fflush(out_);
+}
+
+CsvWriter::~CsvWriter() {}
+
+void CsvWriter::accepted(const Slimfly& _slimfly) {
+  writeRow("candidate", "", _slimfly);
+  fflush(out_);
+}
+
+bool CsvWriter::allCandidates() const {
+  return true;
+}
+
+void CsvWriter::finish(const std::deque<Slimfly>& _results) {
+  for (u64 idx = 0; idx < _results.size(); idx++) {
+    writeRow("result", std::to_string(idx + 1), _results.at(idx));
+  }
+  fflush(out_);
+}
+
+void CsvWriter::writeRow(const char* _record, const std::string& _rank,
+                         const Slimfly& _slimfly) {
+  std::string row = std::string(_record) + "," + _rank + "," +
+      std::to_string(_slimfly.dimensions) + "," +
+      std::to_string(_slimfly.width) + "," +
+      std::to_string(_slimfly.concentration) + "," +
+      std::to_string(_slimfly.terminals) + "," +
+      std::to_string(_slimfly.routers) + "," +
+      std::to_string(_slimfly.routerRadix) + "," +
+      std::to_string(_slimfly.channels) + "," +
+      real(_slimfly.bisections) + "," + real(_slimfly.cost);
+
+  calc_->fillExtValues(_slimfly, &extValues_);
+  for (const std::string& value : extValues_) {
+    row += "," + quote(value);
+  }
+  fprintf(out_, "%s\n", row.c_str());
+}
+
+std::string CsvWriter::quote(const std::string& _field) {
+  if (_field.find_first_of(",\"\n") == std::string::npos) {
+    return _field;
+  }
+  std::string quoted = "\"";
+  for (char c : _field) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_CSVWRITER_H_
+#define SEARCH_CSVWRITER_H_
+
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+
+#include "search/ResultWriter.h"
+
+/*
+ * Writes one CSV row per accepted candidate as it is found ("candidate"
+ * records with an empty rank), followed by the final results ("result"
+ * records ranked from 1). The header row is written on construction.
+ */
+class CsvWriter : public ResultWriter {
+ public:
+  CsvWriter(const Calculator* _calc, FILE* _out);
+  ~CsvWriter();
+  void accepted(const Slimfly& _slimfly) override;
+  bool allCandidates() const override;
+  void finish(const std::deque<Slimfly>& _results) override;
+
+ private:
+  void writeRow(const char* _record, const std::string& _rank,
+                const Slimfly& _slimfly);
+  static std::string quote(const std::string& _field);
+};
+
+#endif  // SEARCH_CSVWRITER_H_
@@ -32,31 +32,45 @@
 #include "search/Engine.h"
 
 #include <strop/strop.h>
-#include <stdlib.h>  // For system
 #include <stdio.h>
 
+#include "search/ResultHeap.h"
+#include "search/SlimflyBlock.h"
+#include "search/SlimflyGraph.h"
 #include "search/util.h"
 #include <string>
-#include <sstream>  // For stringstream
-#include <fstream>
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <stdexcept>
-#include <set>
+#include <utility>
 
 static const u8 HSE_DEBUG = 0;
-static const u32 numPrimes = 75;
-static const u32 kPrimes[] = {
-  5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59,
-  61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131,
-  137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211,
-  223, 227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281, 283, 293,
-  307, 311, 313, 317, 331, 337, 347, 349, 353, 359, 367, 373, 379, 383, 389};
+static const u32 kMinWidth = 4;
 
 CostFunction::CostFunction() {}
 CostFunction::~CostFunction() {}
 
+void CostFunction::costs(SlimflyBlock* _block) const {
+  for (u64 idx = 0; idx < _block->size(); idx++) {
+    _block->cost[idx] = cost(_block->get(idx));
+  }
+}
+
+bool CostFunction::costBounds(SlimflyBlock* _block) const {
+  (void)_block;  // unused
+  return false;
+}
+
+ResultListener::ResultListener() {}
+ResultListener::~ResultListener() {}
+
+bool ResultListener::allCandidates() const {
+  return true;
+}
+
 bool Comparator::operator()(const Slimfly& _lhs, const Slimfly& _rhs) const {
   return _rhs.cost > _lhs.cost;
 }
@@ -64,7 +78,9 @@ bool Comparator::operator()(const Slimfly& _lhs, const Slimfly& _rhs) const {
 Engine::Engine(u64 _minRadix, u64 _maxRadix,
                u64 _minConcentration, u64 _maxConcentration,
                u64 _minTerminals, u64 _maxTerminals, f64 _minBandwidth,
-               u64 _maxResults, const CostFunction* _costFunction)
+               u64 _maxResults, const CostFunction* _costFunction,
+               const Bisector* _bisector, u32 _bisectionTrials,
+               BisectionCache* _bisectionCache, WorkPool* _workPool)
     : minRadix_(_minRadix),
       maxRadix_(_maxRadix),
       minConcentration_(_minConcentration),
@@ -73,13 +89,25 @@ Engine::Engine(u64 _minRadix, u64 _maxRadix,
       maxTerminals_(_maxTerminals),
       minBandwidth_(_minBandwidth),
       maxResults_(_maxResults),
-      costFunction_(_costFunction) {
+      costFunction_(_costFunction),
+      bisector_(_bisector),
+      bisectionTrials_(_bisectionTrials),
+      bisectorKey_(BisectionCache::settingsKey(
+          _bisector->settings() + (_bisectionTrials > 1 ?
+              " trials=" + std::to_string(_bisectionTrials) : ""))),
+      bisectionCache_(_bisectionCache),
+      workPool_(_workPool),
+      heap_(new ResultHeap(_maxResults)),
+      resultsDirty_(false),
+      accepted_(new SlimflyBlock()) {
 
   if (minRadix_ < 2) {
     throw std::runtime_error("minradix must be greater than 1");
   } else if (maxRadix_ < minRadix_) {
     throw std::runtime_error("maxradix must be greater than or equal to "
                              "minradix");
+  } else if (maxRadix_ > U32_MAX) {
+    throw std::runtime_error("maxradix must be less than 4294967296");
   } else if (maxConcentration_ < minConcentration_) {
     throw std::runtime_error("maxconcentration must be greater than or equal "
                              "to minconcentration");
@@ -89,290 +117,521 @@ Engine::Engine(u64 _minRadix, u64 _maxRadix,
   } else if (maxTerminals_ < minTerminals_) {
     throw std::runtime_error("maxterminals must be greater than or equal to "
                              "minterminals");
-  } else if (minBandwidth_ <= 0) {
+  } else if (!(minBandwidth_ > 0) || std::isinf(minBandwidth_)) {
     throw std::runtime_error("minbandwidth must be greater than 0.0");
+  } else if (bisectionTrials_ < 1) {
+    throw std::runtime_error("bisectiontrials must be at least 1");
   }
 }
 
-Engine::~Engine() {}
-
-void Engine::run() {
-  slimfly_ = Slimfly();
+Engine::~Engine() {
+  delete accepted_;
+  delete heap_;
+}
 
-  /* Set dimensions to 2.
-   * No particular use so far
-   */
-  slimfly_.dimensions = 2;
+void Engine::addListener(ResultListener* _listener) {
+  listeners_.push_back(_listener);
+}
 
+void Engine::run() {
+  heap_->clear();
   results_.clear();
+  resultsDirty_ = false;
+  stats_.clear();
+  u64 start = statsClock();
 
-  writeSlimflyAdjList(u32(5), u32(1), "sf_bb.txt");
-  stage1();
+  enumerate();
+  filter();
+
+  /* Candidates that can't beat the worst kept result are skipped, unless a
+   * listener wants to see them all.
+   */
+  bool prune = true;
+  for (ResultListener* listener : listeners_) {
+    prune = prune && !listener->allCandidates();
+  }
+  prune = prune && boundCosts();
+  search(prune);
+
+  graphs_.clear();
+  candidates_.resize(0);
+  accepted_->clear();
+  acceptedOrder_.clear();
+  stats_.totalTime = statsClock() - start;
 }
 
 const std::deque<Slimfly>& Engine::results() const {
+  // the results are only sorted when read
+  if (resultsDirty_) {
+    heap_->sorted(&results_);
+    resultsDirty_ = false;
+  }
   return results_;
 }
 
-void Engine::stage1() {
+const SearchStats& Engine::stats() const {
+  return stats_;
+}
+
+u64 Engine::Candidates::size() const {
+  return graph.size();
+}
+
+void Engine::Candidates::resize(u64 _size) {
+  graph.resize(_size);
+  concentration.resize(_size);
+  terminals.resize(_size);
+  routerRadix.resize(_size);
+  channels.resize(_size);
+  costBound.resize(_size);
+  decided.resize(_size);
+  edgeCut.resize(_size);
+}
+
+void Engine::enumerate() {
+  u64 start = statsClock();
+  graphs_.clear();
+  candidates_.resize(0);
+
   /*
    * Number of dimensions is fixed
    */
-  // find the maximum width of any one dimension
-  u64 maxWidth = round(2 * (maxRadix_ - minConcentration_) / 3.0);
-  if (maxWidth < 5) {
-    return;
+  // find the maximum width of any one dimension, a radix below 2^32 keeps it
+  //  in u32 and the router counts below in u64
+  u64 maxWidth = 0;
+  if (maxRadix_ > minConcentration_) {
+    maxWidth = round(2 * (maxRadix_ - minConcentration_) / 3.0);
   }
-
-  if (HSE_DEBUG >= 6) {
-    printf("1: maxRadix=%lu maxWidth=%lu\n",
-               maxRadix_, maxWidth);
+  if (maxWidth < kMinWidth) {
+    stats_.enumerateTime += statsClock() - start;
+    return;
   }
 
   /*
-   * generate possible dimension widths (S)
+   * generate possible dimension widths (S), Slim Fly graphs exist for every
+   * prime power
    */
-  slimfly_.width = 5;
-  u32 prime_idx = 1;
-  while (true) {
-    // determine the number of routers
-    u64 coeff = round(slimfly_.width / 4.0);
-    int delta = slimfly_.width - 4*coeff;
-    slimfly_.routers = 2 * slimfly_.width * slimfly_.width;
+  std::vector<u32> widths = primePowers(kMinWidth, maxWidth);
+  for (u32 width : widths) {
+    stats_.widths++;
 
-    // minimum current radix
-    u64 baseRadix = 1 + (3 * slimfly_.width - delta) / 2;
+    // determine the number of routers and the radix without terminals
+    Graph graph;
+    graph.width = width;
+    graph.delta = SlimflyGraph::deltaOf(width);
+    graph.routers = 2 * static_cast<u64>(width) * width;
+    graph.baseRadix = (3 * static_cast<u64>(width) - graph.delta) / 2;
 
     // find reasons to skip this case
     //  expr 1: at minimum, there would be 1 terminal per router
     //  expr 2: check minimum current router radix
-    if ((slimfly_.routers <= maxTerminals_) &&
-        (baseRadix <= maxRadix_)) {
-      // if this configuration appears to work so far, use it
-      stage2();
-    } else if (HSE_DEBUG >= 7) {
-      printf("1s: SKIPPING S=%lu\n", slimfly_.width);
+    if (graph.routers > maxTerminals_) {
+      stats_.widthsRejectedTerminals++;
+      continue;
     }
-    // find the next widths configuration
-    if (prime_idx == numPrimes) {
-      printf("Prime index has reached %d. Terminating program.\n",
-        numPrimes);
-      return;
+    if (graph.baseRadix + 1 > maxRadix_) {
+      stats_.widthsRejectedRadix++;
+      continue;
     }
-    slimfly_.width = kPrimes[prime_idx++];
-    // detect when done
-    if (slimfly_.width > maxWidth) {
-      break;
+    if (HSE_DEBUG >= 5) {
+      printf("1: S=%u P=%lu\n", graph.width, graph.routers);
+    }
+
+    /* Try every concentration up to the first one with too many terminals or
+     * too big a radix. That one is enumerated too (and then filtered out), it
+     * is where a one at a time search would have learned to stop.
+     */
+    if (minConcentration_ > maxConcentration_) {
+      continue;
+    }
+    u64 last = std::min(maxConcentration_, std::min(
+        maxTerminals_ / graph.routers + 1, maxRadix_ - graph.baseRadix + 1));
+    last = std::max(last, minConcentration_);
+    u64 first = candidates_.size();
+    u64 count = last - minConcentration_ + 1;
+    u32 index = graphs_.size();
+    graphs_.push_back(graph);
+    candidates_.resize(first + count);
+    for (u64 idx = 0; idx < count; idx++) {
+      candidates_.graph[first + idx] = index;
+      candidates_.concentration[first + idx] = minConcentration_ + idx;
     }
   }
+  stats_.concentrations = candidates_.size();
+  stats_.enumerateTime += statsClock() - start;
 }
 
-void Engine::stage2() {
-  if (HSE_DEBUG >= 5) {
-    printf("2: S=%lu P=%lu\n", slimfly_.width, slimfly_.routers);
+void Engine::filter() {
+  u64 start = statsClock();
+  u64 size = candidates_.size();
+  const Graph* graphs = graphs_.data();
+  const u32* graph = candidates_.graph.data();
+  const u64* concentration = candidates_.concentration.data();
+  u64* terminals = candidates_.terminals.data();
+  u64* routerRadix = candidates_.routerRadix.data();
+  u64* channels = candidates_.channels.data();
+
+  // derived columns, channels are only router to router
+  for (u64 idx = 0; idx < size; idx++) {
+    const Graph& g = graphs[graph[idx]];
+    terminals[idx] = g.routers * concentration[idx];
+    routerRadix[idx] = g.baseRadix + concentration[idx];
+    channels[idx] = g.routers * g.baseRadix / 2;
   }
 
-  // compute the baseRadix (no terminals)
-  u64 baseRadix = 0;
-  u64 coeff = round(slimfly_.width / 4.0);
-  int delta = slimfly_.width - 4*coeff;
-  slimfly_.routers = 2 * slimfly_.width * slimfly_.width;
-  baseRadix = (3 * slimfly_.width - delta) / 2;
-
-  // try possible values for terminals per router ratio
-  for (slimfly_.concentration = minConcentration_;
-       slimfly_.concentration <= maxConcentration_;
-       slimfly_.concentration++) {
-    slimfly_.terminals = slimfly_.routers * slimfly_.concentration;
-    u64 baseRadix2 = baseRadix + slimfly_.concentration;
-    if ((slimfly_.terminals >= minTerminals_) &&
-        (slimfly_.terminals <= maxTerminals_) &&
-        (baseRadix2 <= maxRadix_)) {
-      stage3();
-    } else {
-      if (HSE_DEBUG >= 7) {
-        printf("2s: SKIPPING S=%lu P=%lu T=%lu\n", slimfly_.width,
-               slimfly_.routers, slimfly_.concentration);
-      }
-    }
-    if ((slimfly_.terminals > maxTerminals_) ||
-        (baseRadix2 > maxRadix_)) {
-      break;
-    }
+  /* The tests combine with '&' rather than '&&' and the counters add the
+   * outcomes, so there are no data dependent branches for these loops.
+   */
+  keep_.resize(size);
+  u8* keep = keep_.data();
+  u64 rejectedTerminals = 0;
+  u64 rejectedRadix = 0;
+  u64 tests = 0;
+  u64 rejectedMinRadix = 0;
+  for (u64 idx = 0; idx < size; idx++) {
+    u8 terminalsOk = (terminals[idx] >= minTerminals_) &
+        (terminals[idx] <= maxTerminals_);
+    u8 maxRadixOk = routerRadix[idx] <= maxRadix_;
+    u8 minRadixOk = routerRadix[idx] >= minRadix_;
+    u8 tested = terminalsOk & maxRadixOk;
+    rejectedTerminals += terminalsOk ^ 1;
+    rejectedRadix += terminalsOk & (maxRadixOk ^ 1);
+    tests += tested;
+    rejectedMinRadix += tested & (minRadixOk ^ 1);
+    keep[idx] = tested & minRadixOk;
+  }
+  stats_.concentrationsRejectedTerminals += rejectedTerminals;
+  stats_.concentrationsRejectedRadix += rejectedRadix;
+  stats_.bandwidthTests += tests;
+  stats_.bandwidthRejectedRadix += rejectedMinRadix;
+
+  compact();
+  stats_.filterTime += statsClock() - start;
+}
+
+void Engine::compact() {
+  // moves the kept candidates to the front, keeping their order
+  u64 size = candidates_.size();
+  const u8* keep = keep_.data();
+  u64 kept = 0;
+  for (u64 idx = 0; idx < size; idx++) {
+    candidates_.graph[kept] = candidates_.graph[idx];
+    candidates_.concentration[kept] = candidates_.concentration[idx];
+    candidates_.terminals[kept] = candidates_.terminals[idx];
+    candidates_.routerRadix[kept] = candidates_.routerRadix[idx];
+    candidates_.channels[kept] = candidates_.channels[idx];
+    kept += keep[idx];
   }
+  candidates_.resize(kept);
 }
 
-void Engine::stage3() {
-  if (HSE_DEBUG >= 4) {
-    printf("3: S=%lu T=%lu N=%lu P=%lu\n", slimfly_.width,
-           slimfly_.concentration, slimfly_.terminals,
-           slimfly_.routers);
+bool Engine::boundCosts() {
+  u64 start = statsClock();
+  u64 size = candidates_.size();
+  accepted_->clear();
+  accepted_->reserve(size);
+  for (u64 idx = 0; idx < size; idx++) {
+    const Graph& graph = graphs_[candidates_.graph[idx]];
+    Slimfly slimfly;
+    slimfly.dimensions = 2;
+    slimfly.width = graph.width;
+    slimfly.routers = graph.routers;
+    slimfly.concentration = candidates_.concentration[idx];
+    slimfly.terminals = candidates_.terminals[idx];
+    slimfly.routerRadix = candidates_.routerRadix[idx];
+    slimfly.bisections = 0;
+    slimfly.channels = candidates_.channels[idx];
+    slimfly.cost = 0;
+    accepted_->push(slimfly);
   }
+  bool bounded = costFunction_->costBounds(accepted_);
+  if (bounded) {
+    std::copy(accepted_->cost.begin(), accepted_->cost.end(),
+              candidates_.costBound.begin());
+  }
+  accepted_->clear();
+  stats_.costTime += statsClock() - start;
+  return bounded;
+}
 
-  // find the base radix
-  slimfly_.routerRadix = slimfly_.concentration;
-  u64 coeff = round(slimfly_.width / 4.0);
-  int delta = slimfly_.width - 4*coeff;
-  slimfly_.routers = 2 * slimfly_.width * slimfly_.width;
-  slimfly_.routerRadix += (3 * slimfly_.width - delta) / 2;
-
-  bool tooSmallRadix = (slimfly_.routerRadix < minRadix_);
-  bool tooBigRadix = (slimfly_.routerRadix > maxRadix_);
-
-  // if not already skipped, compute bisection bandwidth
-  bool tooSmallBandwidth = false;
-  int sysOutput = 0;
-
-  if (!tooSmallRadix && !tooBigRadix) {
-    f64 smallestBandwidth = 9999999999;
-    
-    writeSlimflyAdjList(slimfly_.width, delta, "sf_bb.txt");
-    sysOutput = system("gpmetis sf_bb.txt 2 > sf_bb.out");
-    if (sysOutput) {
-      return;
+void Engine::search(bool _prune) {
+  /* Candidates are visited in waves of at most one graph per thread to
+   * bisect, and listeners see the accepted ones as each wave finishes.
+   * Without pruning the waves follow enumeration order, so a graph's
+   * candidates share one wave. Pruning visits them by ascending cost bound
+   * instead and stops at the first candidate whose bound is worse than the
+   * worst kept result after the previous wave. Every candidate after it is
+   * at least as bad, none of them could make it into the results.
+   */
+  u64 size = candidates_.size();
+  std::vector<u64> order(size);
+  for (u64 idx = 0; idx < size; idx++) {
+    order[idx] = idx;
+  }
+  if (_prune) {
+    const std::vector<f64>& costBound = candidates_.costBound;
+    std::stable_sort(order.begin(), order.end(), [&](u64 _a, u64 _b) {
+        return costBound[_a] < costBound[_b];
+      });
+  }
+  u64 maxPending = workPool_->threads();
+
+  std::vector<s64> pendingOf(graphs_.size(), -1);
+  std::vector<u32> pending;
+  std::vector<f64> rejectBelow;
+  std::vector<u64> wave;
+  u64 pos = 0;
+  while (pos < size) {
+    f64 cutoff = (heap_->full() && heap_->size() > 0) ?
+        heap_->worst().cost : INFINITY;
+    if (_prune && candidates_.costBound[order[pos]] > cutoff) {
+      stats_.pruned += size - pos;
+      break;
     }
 
-    // Parse METIS output to obtain edgecuts
-    std::ifstream metisfile("sf_bb.out");
-    std::string nextline;
-    std::string edgecuts_s;
-    while (std::getline(metisfile, nextline)) {
-      if (nextline.find("Edgecut:") != std::string::npos) {
-        std::istringstream ss(nextline);
-        // Need the third word
-        for (int i = 0; i < 3; ++i)
-          ss >> edgecuts_s;
+    // collect the wave and the graphs it needs bisected
+    wave.clear();
+    for (; pos < size; pos++) {
+      u64 idx = order[pos];
+      if (_prune && candidates_.costBound[idx] > cutoff) {
         break;
       }
+      f64 threshold;
+      if (needsBisection(idx, &threshold)) {
+        u32 graph = candidates_.graph[idx];
+        if (pendingOf[graph] < 0) {
+          if (pending.size() >= maxPending) {
+            break;
+          }
+          pendingOf[graph] = pending.size();
+          pending.push_back(graph);
+          rejectBelow.push_back(threshold);
+        } else {
+          f64& lowest = rejectBelow[pendingOf[graph]];
+          lowest = std::min(lowest, threshold);
+        }
+      }
+      wave.push_back(idx);
+    }
+
+    bisectGraphs(pending, rejectBelow);
+    for (u32 graph : pending) {
+      pendingOf[graph] = -1;
     }
+    pending.clear();
+    rejectBelow.clear();
 
-    remove("sf_bb.txt");
-    remove("sf_bb.txt.part.2");
-    remove("sf_bb.out");
+    filterBandwidth(wave);
+    evaluate();
+  }
+}
 
-    int edgecuts_i = std::stoi(edgecuts_s, nullptr, 10);
-    slimfly_.bisections =
-      static_cast <f64> (edgecuts_i) / slimfly_.terminals;
+bool Engine::needsBisection(u64 _idx, f64* _rejectBelow) {
+  // the bounds often decide the bandwidth test on their own
+  const Graph& graph = graphs_[candidates_.graph[_idx]];
+  u64 terminals = candidates_.terminals[_idx];
+  const BisectionBounds& bounds = bisectionBounds(graph.width, graph.delta);
+  candidates_.edgeCut[_idx] = bounds.upper;
+  candidates_.decided[_idx] = boundsDecide(bounds, terminals);
+  if (candidates_.decided[_idx]) {
+    if (static_cast<f64>(bounds.lower) / terminals >= minBandwidth_) {
+      stats_.boundsAccepted++;
+    } else {
+      stats_.boundsRejected++;
+    }
+    return false;
+  }
+  *_rejectBelow = minBandwidth_ * terminals;
+  u64 edgecuts;
+  return !cachedEdgeCut(graph.width, graph.delta, *_rejectBelow, &edgecuts);
+}
 
-    if (slimfly_.bisections < smallestBandwidth) {
-      smallestBandwidth = slimfly_.bisections;
+void Engine::bisectGraphs(const std::vector<u32>& _pending,
+                          const std::vector<f64>& _rejectBelow) {
+  /* Each graph is bisected at the lowest bandwidth threshold of the
+   * candidates waiting on it, a cut that rejects that one also rejects the
+   * others.
+   */
+  std::vector<Bisection> bisections(_pending.size());
+  workPool_->parallelFor(_pending.size(), [&](u64 idx) {
+      const Graph& graph = graphs_[_pending[idx]];
+      bisections[idx] = bisect(graph.width, graph.delta, _rejectBelow[idx]);
+    });
+
+  // store the results in a deterministic order
+  for (u64 idx = 0; idx < _pending.size(); idx++) {
+    const Graph& graph = graphs_[_pending[idx]];
+    bisectionCache_->insert(graph.width, graph.delta, bisectorKey_,
+                            bisections[idx].edgeCut, bisections[idx].exact);
+    addBisectionStats(bisections[idx]);
+  }
+}
+
+void Engine::filterBandwidth(const std::vector<u64>& _wave) {
+  accepted_->clear();
+  accepted_->reserve(_wave.size());
+  acceptedOrder_.clear();
+  u64 rejected = 0;
+  for (u64 idx : _wave) {
+    const Graph& graph = graphs_[candidates_.graph[idx]];
+    Slimfly slimfly;
+    slimfly.dimensions = 2;
+    slimfly.width = graph.width;
+    slimfly.routers = graph.routers;
+    slimfly.concentration = candidates_.concentration[idx];
+    slimfly.terminals = candidates_.terminals[idx];
+    slimfly.routerRadix = candidates_.routerRadix[idx];
+    slimfly.channels = candidates_.channels[idx];
+    slimfly.cost = 0;
+
+    // the bounds' explicit cut may still be the better one
+    u64 edgecuts = candidates_.edgeCut[idx];
+    if (!candidates_.decided[idx]) {
+      edgecuts = std::min(edgecuts, computeEdgeCut(
+          graph.width, graph.delta, slimfly.terminals));
     }
-    if (smallestBandwidth < minBandwidth_) {
-      tooSmallBandwidth = true;
+    slimfly.bisections = static_cast<f64>(edgecuts) / slimfly.terminals;
+    if (slimfly.bisections < minBandwidth_) {
+      rejected++;
       if (HSE_DEBUG >= 7) {
         printf("3s: SKIPPING S=%lu T=%lu N=%lu P=%lu R=%lu B=%lf\n",
-                             slimfly_.width,
-               slimfly_.concentration, slimfly_.terminals,
-               slimfly_.routers,
-               slimfly_.routerRadix,
-               slimfly_.bisections);
-
-        /* Used to debug gpmetis output file parser. */
-        printf("In stage 3, edgecuts is: %d\n", edgecuts_i);
-        printf("In stage 3, terminals is: %lu\n", slimfly_.terminals);
+               slimfly.width, slimfly.concentration, slimfly.terminals,
+               slimfly.routers, slimfly.routerRadix, slimfly.bisections);
       }
+      continue;
     }
-    // if passed all tests, send to next stage
-    if (!tooSmallRadix && !tooBigRadix && !tooSmallBandwidth) {
-      stage4();
-    } else {
-      return;
-    }
+    accepted_->push(slimfly);
+    acceptedOrder_.push_back(idx);
   }
+  stats_.bandwidthRejectedBandwidth += rejected;
 }
 
-void Engine::stage4() {
-  if (HSE_DEBUG >= 3) {
-    printf("4: S=%lu T=%lu N=%lu B=%lf\n", slimfly_.width,
-           slimfly_.concentration, slimfly_.terminals,
-           slimfly_.bisections);
+void Engine::evaluate() {
+  if (accepted_->size() == 0) {
+    return;
   }
+  u64 start = statsClock();
+  costFunction_->costs(accepted_);
+  stats_.costTime += statsClock() - start;
+  stats_.costed += accepted_->size();
 
-  // compute the number of channels (only router to router)
-  slimfly_.channels = slimfly_.routers *
-                      (slimfly_.routerRadix - slimfly_.concentration) / 2;
-  stage5();
+  /* Ties between equal costs go to the earlier enumerated candidate, so the
+   * results don't depend on the order candidates were visited in.
+   */
+  for (u64 idx = 0; idx < accepted_->size(); idx++) {
+    Slimfly slimfly = accepted_->get(idx);
+    if (HSE_DEBUG >= 2) {
+      printf("5: S=%lu T=%lu N=%lu P=%lu R=%lu B=%lf\n", slimfly.width,
+             slimfly.concentration, slimfly.terminals, slimfly.routers,
+             slimfly.routerRadix, slimfly.bisections);
+    }
+    for (ResultListener* listener : listeners_) {
+      listener->accepted(slimfly);
+    }
+    heap_->push(slimfly, acceptedOrder_[idx]);
+  }
+  resultsDirty_ = true;
 }
 
-void Engine::stage5() {
-  if (HSE_DEBUG >= 2) {
-    printf("5: S=%lu T=%lu N=%lu P=%lu R=%lu B=%lf\n", slimfly_.width,
-           slimfly_.concentration, slimfly_.terminals, slimfly_.routers,
-           slimfly_.routerRadix,
-           slimfly_.bisections);
+const BisectionBounds& Engine::bisectionBounds(u32 width, s32 delta) {
+  std::unordered_map<u32, BisectionBounds>::const_iterator it =
+      bounds_.find(width);
+  if (it == bounds_.end()) {
+    u64 start = statsClock();
+    it = bounds_.insert(std::make_pair(width, computeBisectionBounds(
+        width, delta, bisector_->imbalance()))).first;
+    stats_.boundsTime += statsClock() - start;
   }
+  return it->second;
+}
 
-  slimfly_.cost = costFunction_->cost(slimfly_);
+bool Engine::boundsDecide(const BisectionBounds& bounds, u64 terminals) const {
+  // any cut the bisector finds is at least the lower bound and there is a cut
+  //  as small as the upper bound
+  return (static_cast<f64>(bounds.lower) / terminals >= minBandwidth_) ||
+      (static_cast<f64>(bounds.upper) / terminals < minBandwidth_);
+}
 
-  results_.push_back(slimfly_);
-  std::sort(results_.begin(), results_.end(), comparator_);
+bool Engine::cachedEdgeCut(u32 width, s32 delta, f64 rejectBelow,
+                           u64* edgecuts) const {
+  /* An inexact entry is an upper bound on the cut all trials would find, so
+   * it is good enough whenever it already rejects.
+   */
+  bool exact;
+  return bisectionCache_->lookup(width, delta, bisectorKey_, edgecuts,
+                                 &exact) &&
+      (exact || *edgecuts < rejectBelow);
+}
 
-  if (results_.size() > maxResults_) {
-    results_.pop_back();
+u64 Engine::computeEdgeCut(u32 width, s32 delta, u64 terminals) {
+  // the graph only depends on width and delta, reuse across concentrations
+  f64 rejectBelow = minBandwidth_ * terminals;
+  u64 edgecuts;
+  if (cachedEdgeCut(width, delta, rejectBelow, &edgecuts)) {
+    return edgecuts;
   }
+  Bisection bisection = bisect(width, delta, rejectBelow);
+  bisectionCache_->insert(width, delta, bisectorKey_, bisection.edgeCut,
+                          bisection.exact);
+  addBisectionStats(bisection);
+  return bisection.edgeCut;
 }
 
-void Engine::writeSlimflyAdjList(u32 width, u32 delta, std::string filename) {
-
-  std::vector<u32> X, X_i;
-  createGeneratorSet(width, delta, X, X_i);
-
-  u32 numNodes = 2 * width * width;
-  u32 numEdges = 0;
-  std::vector< std::vector<u32> > adjList(numNodes, std::vector<u32>());
-
-  static const u32 NUM_GRAPHS = 2;
-  // link routers via channels: Intra subgraph connections
-  for (u32 graph = 0; graph < NUM_GRAPHS; graph++) {
-    std::vector<u32>& dVtr = (graph == 0) ? X : X_i;
-    std::set<u32> distSet(dVtr.begin(), dVtr.end());
-    for (u32 col = 0; col < width; col++) {
-      for (u32 srcRow = 0; srcRow < width; srcRow++) {
-        for (u32 dstRow = 0; dstRow < width; dstRow++) {
-          // determine the source and destination router
-          std::vector<u32> srcAddr = {graph, col, srcRow};
-          std::vector<u32> dstAddr = {graph, col, dstRow};
-          u32 dist = static_cast<u32>(
-            std::abs<int>(static_cast<int>(dstRow) - srcRow));
-          if (distSet.count(dist)) {
-            adjList.at(ifaceIdFromAddress(srcAddr, width)).push_back(
-              ifaceIdFromAddress(dstAddr, width) + 1);
-            numEdges++;
-          }
-        }
+Engine::Bisection Engine::bisect(u32 width, s32 delta,
+                                 f64 rejectBelow) const {
+  Bisection bisection;
+  u64 start = statsClock();
+  SlimflyGraph graph(width, delta);
+  u64 built = statsClock();
+
+  /* Run the trials concurrently and keep the smallest cut. Only the question
+   * "is the cut below the threshold" matters to a rejected candidate, so the
+   * trials run in decision mode and stop at the first cut below it. Every
+   * candidate waiting on this graph is then rejected whatever the other
+   * trials find, so the trials not yet started are skipped.
+   */
+  u64 threshold = static_cast<u64>(std::ceil(rejectBelow));
+  std::vector<Bisector::Decision> decisions(bisectionTrials_);
+  std::vector<u8> ran(bisectionTrials_, 0);  // one slot each, no sharing
+  std::atomic<bool> rejected(false);
+  workPool_->parallelFor(bisectionTrials_, [&](u64 trial) {
+      if (rejected.load()) {
+        return;
       }
-    }
-  }
-  // link routers via channels: Inter subgraph connections
-  for (u32 x = 0; x < width; x++) {
-    for (u32 y = 0; y < width; y++) {
-      for (u32 m = 0; m < width; m++) {
-        for (u32 c = 0; c < width; c++) {
-          if (y == ((m*x + c) % width)) {
-             // determine the source router
-            std::vector<u32> addr1 = {0, x, y};
-            std::vector<u32> addr2 = {1, m, c};
-
-            adjList.at(ifaceIdFromAddress(addr1, width)).push_back(
-              ifaceIdFromAddress(addr2, width) + 1);
-            numEdges++;
-            adjList.at(ifaceIdFromAddress(addr2, width)).push_back(
-              ifaceIdFromAddress(addr1, width) + 1);
-            numEdges++;
-          }
-        }
+      decisions[trial] = bisector_->cutBelow(
+          graph.offsets(), graph.neighbors(), trial, threshold);
+      ran[trial] = 1;
+      if (decisions[trial].edgeCut < threshold) {
+        rejected.store(true);
       }
+    });
+
+  bisection.edgeCut = U64_MAX;
+  bisection.exact = true;
+  bisection.trials = 0;
+  bisection.cutShort = 0;
+  for (u64 trial = 0; trial < bisectionTrials_; trial++) {
+    if (!ran[trial]) {
+      bisection.exact = false;
+      continue;
     }
-  }
-
-  std::ofstream adjLstFile;
-  adjLstFile.open(filename);
-  adjLstFile << numNodes << " " << (numEdges/2) << std::endl;
-  for (u32 i = 0; i < numNodes; i++) {
-    for (u32 j = 0; j < adjList[i].size(); j++) {
-      adjLstFile << adjList[i][j] << " ";
+    bisection.edgeCut = std::min(bisection.edgeCut, decisions[trial].edgeCut);
+    bisection.trials++;
+    if (!decisions[trial].complete) {
+      bisection.exact = false;
+      bisection.cutShort++;
     }
-    adjLstFile << std::endl;
   }
-  adjLstFile.close();
+  bisection.buildTime = built - start;
+  bisection.partitionTime = statsClock() - built;
+  return bisection;
+}
+
+void Engine::addBisectionStats(const Bisection& bisection) {
+  stats_.partitions++;
+  stats_.trials += bisection.trials;
+  stats_.trialsSkipped += bisectionTrials_ - bisection.trials;
+  stats_.trialsCutShort += bisection.cutShort;
+  stats_.graphBuildTime += bisection.buildTime;
+  stats_.partitionTime += bisection.partitionTime;
 }
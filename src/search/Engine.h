@@ -35,9 +35,16 @@
 #include <prim/prim.h>
 
 #include <deque>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
+#include "search/BisectionBounds.h"
+#include "search/BisectionCache.h"
+#include "search/Bisector.h"
+#include "search/SearchStats.h"
+#include "search/WorkPool.h"
+
 struct Slimfly {
   u64 dimensions;  // L
   u64 width;  // S
@@ -50,11 +57,23 @@ struct Slimfly {
   f64 cost;
 };
 
+struct SlimflyBlock;
+
 class CostFunction {
  public:
   CostFunction();
   virtual ~CostFunction();
   virtual f64 cost(const Slimfly& _slimfly) const = 0;
+
+  // sets the cost column of a whole block, by default one cost() at a time
+  virtual void costs(SlimflyBlock* _block) const;
+
+  /* Sets the cost column of a block to a lower bound of each candidate's
+   * cost, using only what is known before the bisection is computed (all
+   * fields but bisections). Returns false if there is no such bound, which is
+   * the default.
+   */
+  virtual bool costBounds(SlimflyBlock* _block) const;
 };
 
 class Comparator {
@@ -62,17 +81,43 @@ class Comparator {
   bool operator()(const Slimfly& _lhs, const Slimfly& _rhs) const;
 };
 
+/*
+ * A ResultListener is told about every candidate that passes all filters, as
+ * soon as it has been costed and before it competes for a place in the final
+ * results.
+ */
+class ResultListener {
+ public:
+  ResultListener();
+  virtual ~ResultListener();
+  virtual void accepted(const Slimfly& _slimfly) = 0;
+
+  /* Whether the listener must see every candidate that passes the filters.
+   * If no listener does, the engine skips candidates whose cost bound shows
+   * they can't make it into the results. The default is true.
+   */
+  virtual bool allCandidates() const;
+};
+
+class ResultHeap;
+
 class Engine {
  public:
   Engine(u64 _minRadix, u64 _maxRadix,
          u64 _minConcentration, u64 _maxConcentration, u64 _minTerminals,
          u64 _maxTerminals, f64 _minBandwidth,
-         u64 _maxResults, const CostFunction* _costFunction);
+         u64 _maxResults, const CostFunction* _costFunction,
+         const Bisector* _bisector, u32 _bisectionTrials,
+         BisectionCache* _bisectionCache, WorkPool* _workPool);
   ~Engine();
 
+  void addListener(ResultListener* _listener);
   void run();
   const std::deque<Slimfly>& results() const;
 
+  // counters and timers of the last run
+  const SearchStats& stats() const;
+
  private:
   u64 minRadix_;
   u64 maxRadix_;
@@ -83,17 +128,81 @@ class Engine {
   f64 minBandwidth_;
   u64 maxResults_;
   const CostFunction* costFunction_;
-  Comparator comparator_;
-  Slimfly slimfly_;
-  std::deque<Slimfly> results_;
+  const Bisector* bisector_;
+  u32 bisectionTrials_;
+  u64 bisectorKey_;
+  BisectionCache* bisectionCache_;
+  WorkPool* workPool_;
+  ResultHeap* heap_;
+  mutable std::deque<Slimfly> results_;
+  mutable bool resultsDirty_;
+  std::vector<ResultListener*> listeners_;
+  std::unordered_map<u32, BisectionBounds> bounds_;
+  SearchStats stats_;
+
+  /* run() is a pipeline of passes over whole columns of candidates:
+   *  enumerate()       stage 1 and 2: every (width, concentration) pair the
+   *                    loop bounds allow
+   *  filter()          stage 2 and 3: branch-free terminals and radix tests,
+   *                    channel count
+   *  boundCosts()      stage 3: cost lower bounds, if the search may prune
+   *  search()          stage 3 to 5, in waves of candidates:
+   *   bisectGraphs()    one edge cut per distinct graph of the wave
+   *   filterBandwidth() bandwidth test
+   *   evaluate()        batch cost, listeners and the result heap
+   */
+  struct Graph {
+    u32 width;
+    s32 delta;
+    u64 routers;
+    u64 baseRadix;  // router radix without terminals
+  };
+  struct Candidates {
+    std::vector<u32> graph;  // index into graphs_
+    std::vector<u64> concentration;
+    std::vector<u64> terminals;
+    std::vector<u64> routerRadix;
+    std::vector<u64> channels;
+    std::vector<f64> costBound;
+    std::vector<u8> decided;  // bandwidth test decided by the bounds
+    std::vector<u64> edgeCut;
+
+    u64 size() const;
+    void resize(u64 _size);
+  };
+  std::vector<Graph> graphs_;
+  Candidates candidates_;
+  std::vector<u8> keep_;  // filter scratch, 1 per surviving candidate
+  SlimflyBlock* accepted_;  // stage5 candidates to be costed
+  std::vector<u64> acceptedOrder_;  // their enumeration order
+
+  void enumerate();
+  void filter();
+  void compact();
+  bool boundCosts();
+  void search(bool _prune);
+  bool needsBisection(u64 _idx, f64* _rejectBelow);
+  void bisectGraphs(const std::vector<u32>& _pending,
+                    const std::vector<f64>& _rejectBelow);
+  void filterBandwidth(const std::vector<u64>& _wave);
+  void evaluate();
 
-  void stage1();
-  void stage2();
-  void stage3();
-  void stage4();
-  void stage5();
+  const BisectionBounds& bisectionBounds(u32 width, s32 delta);
+  bool boundsDecide(const BisectionBounds& bounds, u64 terminals) const;
+  struct Bisection {
+    u64 edgeCut;
+    bool exact;  // false if trials were skipped or cut short
+    u64 trials;
+    u64 cutShort;
+    u64 buildTime;
+    u64 partitionTime;
+  };
 
-  void writeSlimflyAdjList(u32 width, u32 delta, std::string filename);
+  bool cachedEdgeCut(u32 width, s32 delta, f64 rejectBelow,
+                     u64* edgecuts) const;
+  u64 computeEdgeCut(u32 width, s32 delta, u64 terminals);
+  Bisection bisect(u32 width, s32 delta, f64 rejectBelow) const;
+  void addBisectionStats(const Bisection& bisection);
 };
 
 #endif  // SEARCH_ENGINE_H_
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/Engine.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <deque>
+#include <stdexcept>
+
+#include "search/BisectionCache.h"
+#include "search/MultilevelBisector.h"
+#include "search/RouterChannelCount.h"
+#include "search/WorkPool.h"
+
+namespace {
+
+// counts accepted candidates and the partitions done when the first arrived
+class Listener : public ResultListener {
+ public:
+  Listener(const Engine* _engine, bool _all)
+      : engine_(_engine), all_(_all), accepted_(0), firstPartitions_(0) {}
+  void accepted(const Slimfly& _slimfly) override {
+    (void)_slimfly;  // unused
+    if (accepted_++ == 0) {
+      firstPartitions_ = engine_->stats().partitions;
+    }
+  }
+  bool allCandidates() const override {
+    return all_;
+  }
+  u64 acceptedCount() const {
+    return accepted_;
+  }
+  u64 firstPartitions() const {
+    return firstPartitions_;
+  }
+
+ private:
+  const Engine* engine_;
+  bool all_;
+  u64 accepted_;
+  u64 firstPartitions_;
+};
+
+struct SearchRun {
+  std::deque<Slimfly> results;
+  SearchStats stats;
+  u64 accepted;
+  u64 firstPartitions;
+};
+
+SearchRun search(u64 _maxResults, bool _all, u32 _threads) {
+  RouterChannelCount calc;
+  MultilevelBisector bisector(12345);
+  BisectionCache cache;
+  WorkPool pool(_threads);
+  Engine engine(2, 200, 1, U64_MAX, 1000, 1000000, 0.5, _maxResults, &calc,
+                &bisector, 1, &cache, &pool);
+  Listener listener(&engine, _all);
+  engine.addListener(&listener);
+  engine.run();
+  SearchRun run = {engine.results(), engine.stats(), listener.acceptedCount(),
+             listener.firstPartitions()};
+  return run;
+}
+
+void expectSameResults(const SearchRun& _a, const SearchRun& _b) {
+  ASSERT_EQ(_a.results.size(), _b.results.size());
+  for (u64 idx = 0; idx < _a.results.size(); idx++) {
+    EXPECT_EQ(_a.results[idx].width, _b.results[idx].width);
+    EXPECT_EQ(_a.results[idx].concentration, _b.results[idx].concentration);
+    EXPECT_EQ(_a.results[idx].bisections, _b.results[idx].bisections);
+    EXPECT_EQ(_a.results[idx].cost, _b.results[idx].cost);
+  }
+}
+
+}  // namespace
+
+TEST(Engine, pruning) {
+  // skipping candidates by cost bound doesn't change the results
+  for (u64 maxResults : {1u, 5u}) {
+    SearchRun pruned = search(maxResults, false, 1);
+    SearchRun full = search(maxResults, true, 1);
+    expectSameResults(pruned, full);
+    EXPECT_GT(pruned.stats.pruned, 0u);
+    EXPECT_EQ(full.stats.pruned, 0u);
+    EXPECT_LT(pruned.stats.partitions, full.stats.partitions);
+    EXPECT_LT(pruned.accepted, full.accepted);
+  }
+}
+
+TEST(Engine, threads) {
+  // wider waves only prune less, the results stay the same
+  for (bool all : {false, true}) {
+    SearchRun single = search(5, all, 1);
+    SearchRun multi = search(5, all, 3);
+    expectSameResults(single, multi);
+    if (all) {
+      EXPECT_EQ(single.accepted, multi.accepted);
+      EXPECT_EQ(single.stats.partitions, multi.stats.partitions);
+    }
+  }
+}
+
+TEST(Engine, streaming) {
+  // listeners that see every candidate get them wave by wave, long before
+  //  the last graph is bisected
+  SearchRun full = search(1, true, 1);
+  ASSERT_GT(full.stats.partitions, 1u);
+  EXPECT_LT(full.firstPartitions, full.stats.partitions);
+}
+
+TEST(Engine, maxRadix) {
+  // widths are u32, a radix that would allow wider ones is an error
+  RouterChannelCount calc;
+  MultilevelBisector bisector(12345);
+  BisectionCache cache;
+  WorkPool pool(1);
+  EXPECT_THROW(Engine(2, 6442450950lu, 1, U64_MAX, 100, 1000, 0.5, 5, &calc,
+                      &bisector, 1, &cache, &pool),
+               std::runtime_error);
+}
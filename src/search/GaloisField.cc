@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/GaloisField.h"
+
+#include <cassert>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "search/util.h"
+
+/* Multiplies two polynomials over GF(p), given as coefficient vectors of
+ * length k, modulo the monic polynomial x^k + c[k-1] x^(k-1) + ... + c[0].
+ */
+static std::vector<u32> polyMulMod(const std::vector<u32>& _a,
+                                   const std::vector<u32>& _b,
+                                   const std::vector<u32>& _poly, u32 _p) {
+  u32 k = _poly.size();
+  std::vector<u64> product(2 * k - 1, 0);
+  for (u32 i = 0; i < k; i++) {
+    for (u32 j = 0; j < k; j++) {
+      product[i + j] = (product[i + j] + static_cast<u64>(_a[i]) * _b[j]) % _p;
+    }
+  }
+  // reduce from the top, x^k = -(c[k-1] x^(k-1) + ... + c[0])
+  for (u32 i = 2 * k - 2; i >= k; i--) {
+    u64 top = product[i];
+    product[i] = 0;
+    for (u32 j = 0; j < k; j++) {
+      product[i - k + j] = (product[i - k + j] + (_p - top) * _poly[j]) % _p;
+    }
+  }
+  return std::vector<u32>(product.begin(), product.begin() + k);
+}
+
+/* Computes x^_exponent modulo the polynomial by repeated squaring. */
+static std::vector<u32> polyPowX(u64 _exponent, const std::vector<u32>& _poly,
+                                 u32 _p) {
+  u32 k = _poly.size();
+  std::vector<u32> result(k, 0);
+  std::vector<u32> base(k, 0);
+  result[0] = 1;
+  if (k > 1) {
+    base[1] = 1;
+  } else {
+    base[0] = (_p - _poly[0]) % _p;
+  }
+  while (_exponent > 0) {
+    if (_exponent & 1) {
+      result = polyMulMod(result, base, _poly, _p);
+    }
+    base = polyMulMod(base, base, _poly, _p);
+    _exponent >>= 1;
+  }
+  return result;
+}
+
+/* Checks that x has order exactly q-1 modulo the polynomial, i.e. that the
+ * polynomial is primitive: x^(q-1) = 1 and x^((q-1)/r) != 1 for every prime
+ * r | q-1.
+ */
+static bool isPrimitivePolynomial(const std::vector<u32>& _poly, u32 _p,
+                                  u32 _order,
+                                  const std::vector<u32>& _factors) {
+  std::vector<u32> one(_poly.size(), 0);
+  one[0] = 1;
+  if (polyPowX(_order - 1, _poly, _p) != one) {
+    return false;
+  }
+  for (u32 factor : _factors) {
+    if (polyPowX((_order - 1) / factor, _poly, _p) == one) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Multiplies a polynomial (base p digits) by x modulo the monic polynomial
+ * x^k + c[k-1] x^(k-1) + ... + c[0].
+ */
+static u32 timesX(u32 _value, const std::vector<u32>& _poly, u32 _p) {
+  u32 k = _poly.size();
+  std::vector<u32> digits(k);
+  for (u32 i = 0; i < k; i++) {
+    digits[i] = _value % _p;
+    _value /= _p;
+  }
+  // shift up, x^k reduces to -(c[k-1] x^(k-1) + ... + c[0])
+  u32 top = digits[k - 1];
+  for (u32 i = k - 1; i > 0; i--) {
+    digits[i] = digits[i - 1];
+  }
+  digits[0] = 0;
+  u32 result = 0;
+  for (u32 i = k; i > 0; i--) {
+    u32 coeff = (digits[i - 1] + (_p - top) * _poly[i - 1]) % _p;
+    result = result * _p + coeff;
+  }
+  return result;
+}
+
+GaloisField::GaloisField(u32 _order)
+    : order_(_order) {
+  if (!isPrimePower(order_, &characteristic_, &degree_)) {
+    throw std::runtime_error("GF(q) requires a prime power, got " +
+                             std::to_string(order_));
+  }
+  u32 p = characteristic_;
+  u32 k = degree_;
+  exp_.resize(2 * (order_ - 1));
+  log_.assign(order_, 0);
+
+  if (k == 1) {
+    // prime field, use the smallest primitive root
+    primitive_ = findPrimitiveRoot(order_);
+    u32 value = 1;
+    for (u32 e = 0; e < order_ - 1; e++) {
+      exp_[e] = value;
+      value = static_cast<u64>(value) * primitive_ % order_;
+    }
+  } else {
+    // extension field, search for a primitive polynomial so that x
+    //  generates all q-1 non-zero elements
+    std::vector<u32> factors = primeFactors(order_ - 1);
+    std::vector<u32> poly(k, 0);
+    bool found = false;
+    for (u32 code = 1; code < order_ && !found; code++) {
+      u32 rest = code;
+      for (u32 i = 0; i < k; i++) {
+        poly[i] = rest % p;
+        rest /= p;
+      }
+      found = (poly[0] != 0) &&
+          isPrimitivePolynomial(poly, p, order_, factors);
+    }
+    assert(found);
+    u32 value = 1;
+    for (u32 e = 0; e < order_ - 1; e++) {
+      exp_[e] = value;
+      value = timesX(value, poly, p);
+    }
+    primitive_ = p;  // the polynomial x
+  }
+
+  // log table and the second period of the antilog table
+  for (u32 e = 0; e < order_ - 1; e++) {
+    log_[exp_[e]] = e;
+    exp_[e + order_ - 1] = exp_[e];
+  }
+
+  if (k > 1) {
+    // -a = x^((q-1)/2) a for odd p, every element is its own negative for
+    //  p = 2
+    neg_.resize(order_);
+    neg_[0] = 0;
+    for (u32 a = 1; a < order_; a++) {
+      neg_[a] = (p == 2) ? a : exp_[log_[a] + (order_ - 1) / 2];
+    }
+
+    // Zech logarithms for odd p, 1 + x^n only adds 1 to the lowest digit
+    if (p != 2) {
+      zech_.resize(order_ - 1);
+      for (u32 n = 0; n < order_ - 1; n++) {
+        u32 value = exp_[n];
+        u32 sum = value - value % p + (value % p + 1) % p;
+        if (sum == 0) {
+          zech_[n] = kNoZech;
+        } else {
+          zech_[n] = log_[sum];
+        }
+      }
+    }
+  }
+}
+
+GaloisField::~GaloisField() {}
+
+std::shared_ptr<const GaloisField> GaloisField::get(u32 _order) {
+  static std::mutex lock;
+  static std::unordered_map<u32, std::shared_ptr<const GaloisField> > cache;
+  std::lock_guard<std::mutex> guard(lock);
+  std::shared_ptr<const GaloisField>& field = cache[_order];
+  if (!field) {
+    field = std::make_shared<const GaloisField>(_order);
+  }
+  return field;
+}
+
+u32 GaloisField::order() const {
+  return order_;
+}
+
+u32 GaloisField::characteristic() const {
+  return characteristic_;
+}
+
+u32 GaloisField::degree() const {
+  return degree_;
+}
+
+u32 GaloisField::primitive() const {
+  return primitive_;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_GALOISFIELD_H_
+#define SEARCH_GALOISFIELD_H_
+
+#include <prim/prim.h>
+
+#include <memory>
+#include <vector>
+
+/*
+ * Arithmetic in the finite field GF(q) for a prime power q = p^k. Elements
+ * are the integers 0 ... q-1. For prime fields this is plain arithmetic mod
+ * q. For extension fields an element encodes the coefficients of a polynomial
+ * over GF(p) as base p digits (digit i is the coefficient of x^i) modulo a
+ * primitive polynomial, and x is the primitive element.
+ *
+ * All operations are table lookups: multiplication goes through log/antilog
+ * tables. Extension field addition is XOR of the bits for p = 2 and goes
+ * through a Zech logarithm table otherwise: x^i + x^j = x^(i + Z(j - i))
+ * where x^Z(n) = 1 + x^n. Every table has O(q) entries and costs O(q) to
+ * build, get() still hands out one shared instance per order.
+ */
+class GaloisField {
+ public:
+  explicit GaloisField(u32 _order);
+  ~GaloisField();
+
+  static std::shared_ptr<const GaloisField> get(u32 _order);
+
+  u32 order() const;
+  u32 characteristic() const;
+  u32 degree() const;
+  u32 primitive() const;
+
+  u32 add(u32 _a, u32 _b) const;
+  u32 sub(u32 _a, u32 _b) const;
+  u32 neg(u32 _a) const;
+  u32 mul(u32 _a, u32 _b) const;
+  // primitive()^_exponent
+  u32 exp(u64 _exponent) const;
+  // the discrete logarithm of a non-zero element
+  u32 log(u32 _a) const;
+
+ private:
+  u32 order_;
+  u32 characteristic_;
+  u32 degree_;
+  u32 primitive_;
+  std::vector<u32> exp_;  // two periods long so mul needs no modulo
+  std::vector<u32> log_;
+  std::vector<u32> zech_;  // odd characteristic extension fields only
+  std::vector<u32> neg_;  // extension fields only
+
+  static const u32 kNoZech = U32_MAX;  // 1 + x^n = 0
+};
+
+inline u32 GaloisField::add(u32 _a, u32 _b) const {
+  if (degree_ == 1) {
+    u32 sum = _a + _b;
+    return (sum >= order_) ? sum - order_ : sum;
+  }
+  if (characteristic_ == 2) {
+    return _a ^ _b;
+  }
+  if (_a == 0 || _b == 0) {
+    return _a | _b;
+  }
+  u32 logA = log_[_a];
+  u32 logB = log_[_b];
+  u32 zech = zech_[(logB >= logA) ? logB - logA : logB + order_ - 1 - logA];
+  return (zech == kNoZech) ? 0 : exp_[logA + zech];
+}
+
+inline u32 GaloisField::neg(u32 _a) const {
+  if (degree_ == 1) {
+    return (_a == 0) ? 0 : order_ - _a;
+  }
+  return neg_[_a];
+}
+
+inline u32 GaloisField::sub(u32 _a, u32 _b) const {
+  return add(_a, neg(_b));
+}
+
+inline u32 GaloisField::mul(u32 _a, u32 _b) const {
+  if (_a == 0 || _b == 0) {
+    return 0;
+  }
+  return exp_[log_[_a] + log_[_b]];
+}
+
+inline u32 GaloisField::exp(u64 _exponent) const {
+  return exp_[_exponent % (order_ - 1)];
+}
+
+inline u32 GaloisField::log(u32 _a) const {
+  return log_[_a];
+}
+
+#endif  // SEARCH_GALOISFIELD_H_
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/GaloisField.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <random>
+#include <vector>
+
+static const u32 kSmallOrders[] = {
+  2, 3, 4, 5, 7, 8, 9, 11, 13, 16, 25, 27, 32, 49};
+static const u32 kLargeOrders[] = {
+  125, 243, 343, 1024, 2187, 4096, 6561};
+
+// digit-wise addition mod p, the definition the tables must agree with
+static u32 referenceAdd(const GaloisField& _field, u32 _a, u32 _b) {
+  u32 p = _field.characteristic();
+  u32 sum = 0;
+  u32 scale = 1;
+  for (u32 i = 0; i < _field.degree(); i++) {
+    sum += ((_a % p + _b % p) % p) * scale;
+    _a /= p;
+    _b /= p;
+    scale *= p;
+  }
+  return sum;
+}
+
+static void checkTriple(const GaloisField& _field, u32 _a, u32 _b, u32 _c) {
+  ASSERT_EQ(_field.add(_a, _b), referenceAdd(_field, _a, _b));
+  ASSERT_EQ(_field.add(_a, _b), _field.add(_b, _a));
+  ASSERT_EQ(_field.mul(_a, _b), _field.mul(_b, _a));
+  ASSERT_EQ(_field.add(_field.add(_a, _b), _c),
+            _field.add(_a, _field.add(_b, _c)));
+  ASSERT_EQ(_field.mul(_field.mul(_a, _b), _c),
+            _field.mul(_a, _field.mul(_b, _c)));
+  ASSERT_EQ(_field.mul(_a, _field.add(_b, _c)),
+            _field.add(_field.mul(_a, _b), _field.mul(_a, _c)));
+  ASSERT_EQ(_field.sub(_field.add(_a, _b), _b), _a);
+}
+
+static void checkUnits(const GaloisField& _field) {
+  u32 q = _field.order();
+  for (u32 a = 0; a < q; a++) {
+    ASSERT_EQ(_field.add(a, 0), a);
+    ASSERT_EQ(_field.mul(a, 1), a);
+    ASSERT_EQ(_field.mul(a, 0), 0u);
+    ASSERT_EQ(_field.add(a, _field.neg(a)), 0u);
+    if (a != 0) {
+      // every non-zero element has an inverse
+      u32 inverse = _field.exp(q - 1 - _field.log(a));
+      ASSERT_EQ(_field.mul(a, inverse), 1u);
+    }
+  }
+}
+
+static void checkPrimitive(const GaloisField& _field) {
+  // the primitive element has order q-1, its powers are every non-zero
+  //  element once
+  u32 q = _field.order();
+  std::vector<bool> seen(q, false);
+  u32 power = 1;
+  for (u32 e = 0; e < q - 1; e++) {
+    ASSERT_EQ(_field.exp(e), power);
+    ASSERT_NE(power, 0u);
+    ASSERT_FALSE(seen[power]) << "order " << q << " exponent " << e;
+    seen[power] = true;
+    ASSERT_EQ(_field.log(power), e);
+    power = _field.mul(power, _field.primitive());
+  }
+  ASSERT_EQ(power, 1u);
+}
+
+TEST(GaloisField, smallFields) {
+  for (u32 q : kSmallOrders) {
+    GaloisField field(q);
+    ASSERT_EQ(field.order(), q);
+    checkUnits(field);
+    checkPrimitive(field);
+    for (u32 a = 0; a < q; a++) {
+      for (u32 b = 0; b < q; b++) {
+        for (u32 c = 0; c < q; c++) {
+          checkTriple(field, a, b, c);
+        }
+      }
+    }
+  }
+}
+
+TEST(GaloisField, largeFields) {
+  std::mt19937_64 random(7);
+  for (u32 q : kLargeOrders) {
+    GaloisField field(q);
+    checkUnits(field);
+    checkPrimitive(field);
+    std::uniform_int_distribution<u32> element(0, q - 1);
+    for (u32 trial = 0; trial < 100000; trial++) {
+      checkTriple(field, element(random), element(random), element(random));
+    }
+  }
+}
+
+TEST(GaloisField, shared) {
+  EXPECT_EQ(GaloisField::get(9).get(), GaloisField::get(9).get());
+  EXPECT_NE(GaloisField::get(9).get(), GaloisField::get(27).get());
+}
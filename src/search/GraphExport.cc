@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/GraphExport.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+static const char kMagic[8] = {'S', 'F', 'G', 'R', 'A', 'P', 'H', '\0'};
+static const u32 kVersion = 1;
+static const u64 kBufferSize = 1 << 20;
+
+static u64 alignUp(u64 _value) {
+  return (_value + 7) & ~static_cast<u64>(7);
+}
+
+static void writeAll(FILE* _file, const void* _data, u64 _size,
+                     const std::string& _path) {
+  if (_size > 0 && fwrite(_data, 1, _size, _file) != _size) {
+    fclose(_file);
+    throw std::runtime_error("unable to write graph file: " + _path);
+  }
+}
+
+void GraphExport::writeBinary(const SlimflyGraph& _graph,
+                              const std::string& _path) {
+  const std::vector<u32>& offsets = _graph.offsets();
+  const std::vector<u32>& neighbors = _graph.neighbors();
+
+  Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.width = _graph.width();
+  header.delta = _graph.delta();
+  header.numNodes = _graph.numNodes();
+  header.numEntries = neighbors.size();
+  header.offsetsStart = alignUp(sizeof(header));
+  u64 offsetsSize = offsets.size() * sizeof(u32);
+  header.neighborsStart = alignUp(header.offsetsStart + offsetsSize);
+
+  FILE* file = fopen(_path.c_str(), "wb");
+  if (file == nullptr) {
+    throw std::runtime_error("unable to create graph file: " + _path);
+  }
+
+  // the arrays are written straight from the graph
+  static const char kPadding[8] = {0};
+  writeAll(file, &header, sizeof(header), _path);
+  writeAll(file, kPadding, header.offsetsStart - sizeof(header), _path);
+  writeAll(file, offsets.data(), offsetsSize, _path);
+  writeAll(file, kPadding,
+           header.neighborsStart - header.offsetsStart - offsetsSize, _path);
+  writeAll(file, neighbors.data(), neighbors.size() * sizeof(u32), _path);
+  if (fclose(file) != 0) {
+    throw std::runtime_error("unable to write graph file: " + _path);
+  }
+}
+
+void GraphExport::writeMetis(const SlimflyGraph& _graph,
+                             const std::string& _path) {
+  const std::vector<u32>& offsets = _graph.offsets();
+  const std::vector<u32>& neighbors = _graph.neighbors();
+
+  FILE* file = fopen(_path.c_str(), "w");
+  if (file == nullptr) {
+    throw std::runtime_error("unable to create graph file: " + _path);
+  }
+
+  // format into a large buffer and hand it to the file in big blocks
+  std::vector<char> buffer(kBufferSize);
+  u64 used = 0;
+  used += snprintf(buffer.data(), kBufferSize, "%u %lu\n",
+                   _graph.numNodes(), _graph.numEdges());
+  for (u32 node = 0; node < _graph.numNodes(); node++) {
+    for (u32 idx = offsets[node]; idx < offsets[node + 1]; idx++) {
+      // a u32 and the separator need at most 11 bytes
+      if (used + 12 > kBufferSize) {
+        writeAll(file, buffer.data(), used, _path);
+        used = 0;
+      }
+      char digits[10];
+      u32 count = 0;
+      u32 value = neighbors[idx] + 1;  // METIS is 1-based
+      do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+      } while (value > 0);
+      while (count > 0) {
+        buffer[used++] = digits[--count];
+      }
+      buffer[used++] = ' ';
+    }
+    if (used + 1 > kBufferSize) {
+      writeAll(file, buffer.data(), used, _path);
+      used = 0;
+    }
+    buffer[used++] = '\n';
+  }
+  writeAll(file, buffer.data(), used, _path);
+  if (fclose(file) != 0) {
+    throw std::runtime_error("unable to write graph file: " + _path);
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_GRAPHEXPORT_H_
+#define SEARCH_GRAPHEXPORT_H_
+
+#include <prim/prim.h>
+
+#include <string>
+
+#include "search/SlimflyGraph.h"
+
+/*
+ * Writers for router graphs handed to other tools.
+ *
+ * The binary CSR file is meant to be memory mapped as is. All values are
+ * native endian and every section starts 8-byte aligned:
+ *   Header  (48 bytes, see below)
+ *   u32     offsets[numNodes + 1]   (padded to 8 bytes)
+ *   u32     neighbors[numEntries]   (both directions, 0-based)
+ *
+ * The METIS file is the 1-based text format read by gpmetis.
+ *
+ * Both writers throw std::runtime_error when the file can't be written.
+ */
+class GraphExport {
+ public:
+  struct Header {
+    char magic[8];  // "SFGRAPH" followed by a zero byte
+    u32 version;
+    u32 width;
+    s32 delta;
+    u32 numNodes;
+    u64 numEntries;  // length of the neighbors array
+    u64 offsetsStart;  // byte offset of the offsets array
+    u64 neighborsStart;  // byte offset of the neighbors array
+  };
+
+  static void writeBinary(const SlimflyGraph& _graph,
+                          const std::string& _path);
+  static void writeMetis(const SlimflyGraph& _graph,
+                         const std::string& _path);
+};
+
+#endif  // SEARCH_GRAPHEXPORT_H_
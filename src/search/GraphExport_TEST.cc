@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/GraphExport.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::string graphPath(const std::string& _name) {
+  std::string path = ::testing::TempDir() + "/" + _name + "_" +
+      std::to_string(getpid());
+  unlink(path.c_str());
+  return path;
+}
+
+TEST(GraphExport, binary) {
+  for (u32 width : {5u, 7u, 8u, 49u}) {
+    SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+    std::string path = graphPath("export_binary");
+    GraphExport::writeBinary(graph, path);
+
+    // map it the way a downstream tool would
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    struct stat info;
+    ASSERT_EQ(fstat(fd, &info), 0);
+    u64 size = info.st_size;
+    ASSERT_GE(size, sizeof(GraphExport::Header));
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    ASSERT_NE(map, MAP_FAILED);
+    const char* base = static_cast<const char*>(map);
+
+    const GraphExport::Header* header =
+        reinterpret_cast<const GraphExport::Header*>(base);
+    EXPECT_EQ(memcmp(header->magic, "SFGRAPH", 8), 0);
+    EXPECT_EQ(header->version, 1u);
+    EXPECT_EQ(header->width, width);
+    EXPECT_EQ(header->delta, graph.delta());
+    EXPECT_EQ(header->numNodes, graph.numNodes());
+    EXPECT_EQ(header->numEntries, graph.neighbors().size());
+    EXPECT_EQ(header->offsetsStart % 8, 0u);
+    EXPECT_EQ(header->neighborsStart % 8, 0u);
+    EXPECT_GE(header->offsetsStart, sizeof(GraphExport::Header));
+    EXPECT_GE(header->neighborsStart,
+              header->offsetsStart + (header->numNodes + 1) * sizeof(u32));
+    ASSERT_EQ(size, header->neighborsStart + header->numEntries * sizeof(u32));
+
+    // the arrays are usable in place
+    const u32* offsets =
+        reinterpret_cast<const u32*>(base + header->offsetsStart);
+    const u32* neighbors =
+        reinterpret_cast<const u32*>(base + header->neighborsStart);
+    EXPECT_EQ(std::vector<u32>(offsets, offsets + header->numNodes + 1),
+              graph.offsets()) << "width " << width;
+    EXPECT_EQ(std::vector<u32>(neighbors, neighbors + header->numEntries),
+              graph.neighbors()) << "width " << width;
+
+    munmap(map, size);
+    unlink(path.c_str());
+  }
+}
+
+TEST(GraphExport, metis) {
+  // width 49 writes about 1.7 MiB, past the 1 MiB buffer
+  for (u32 width : {5u, 49u}) {
+    SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+    std::string path = graphPath("export_metis");
+    GraphExport::writeMetis(graph, path);
+
+    FILE* file = fopen(path.c_str(), "r");
+    ASSERT_NE(file, nullptr);
+    std::string text;
+    char buf[4096];
+    for (u64 read; (read = fread(buf, 1, sizeof(buf), file)) > 0;) {
+      text.append(buf, read);
+    }
+    fclose(file);
+    unlink(path.c_str());
+    if (width == 49) {
+      EXPECT_GT(text.size(), 1u << 20);
+    }
+
+    // "n m", then one row of 1-based neighbors per router
+    std::vector<std::string> rows;
+    std::string::size_type start = 0;
+    std::string::size_type end;
+    while ((end = text.find('\n', start)) != std::string::npos) {
+      rows.push_back(text.substr(start, end - start));
+      start = end + 1;
+    }
+    EXPECT_EQ(start, text.size());
+    ASSERT_EQ(rows.size(), graph.numNodes() + 1u);
+    EXPECT_EQ(rows[0], std::to_string(graph.numNodes()) + " " +
+              std::to_string(graph.numEdges()));
+    for (u32 node = 0; node < graph.numNodes(); node++) {
+      std::vector<u32> row;
+      const char* pos = rows[node + 1].c_str();
+      char* next;
+      for (u64 value; (value = strtoul(pos, &next, 10)), next != pos;
+           pos = next) {
+        ASSERT_GE(value, 1u);
+        ASSERT_LE(value, graph.numNodes());
+        row.push_back(value - 1);
+      }
+      std::vector<u32> expected(
+          graph.neighbors().begin() + graph.offsets()[node],
+          graph.neighbors().begin() + graph.offsets()[node + 1]);
+      ASSERT_EQ(row, expected) << "width " << width << " router " << node;
+    }
+  }
+}
+
+TEST(GraphExport, unwritable) {
+  SlimflyGraph graph(5, SlimflyGraph::deltaOf(5));
+  std::string path = graphPath("missing") + "/graph";
+  EXPECT_THROW(GraphExport::writeBinary(graph, path), std::runtime_error);
+  EXPECT_THROW(GraphExport::writeMetis(graph, path), std::runtime_error);
+}
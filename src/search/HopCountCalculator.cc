@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/HopCountCalculator.h"
+
+#include <cstdio>
+
+#include "search/SlimflyGraph.h"
+
+HopCountCalculator::HopCountCalculator(const Calculator* _calc,
+                                       WorkPool* _workPool)
+    : calc_(_calc), workPool_(_workPool), fields_(_calc->extFields()) {
+  fields_.push_back("Diameter");
+  fields_.push_back("AvgHops");
+}
+
+HopCountCalculator::~HopCountCalculator() {}
+
+f64 HopCountCalculator::cost(const Slimfly& _slimfly) const {
+  return calc_->cost(_slimfly);
+}
+
+void HopCountCalculator::costs(SlimflyBlock* _block) const {
+  calc_->costs(_block);
+}
+
+bool HopCountCalculator::costBounds(SlimflyBlock* _block) const {
+  return calc_->costBounds(_block);
+}
+
+const std::vector<std::string>& HopCountCalculator::extFields() const {
+  return fields_;
+}
+
+std::unordered_map<std::string, std::string> HopCountCalculator::extValues(
+    const Slimfly& _slimfly) const {
+  std::unordered_map<std::string, std::string> values =
+      calc_->extValues(_slimfly);
+  HopCounts counts = hopCounts(_slimfly.width);
+  values["Diameter"] = diameter(counts);
+  values["AvgHops"] = averageHops(counts);
+  return values;
+}
+
+void HopCountCalculator::fillExtValues(
+    const Slimfly& _slimfly, std::vector<std::string>* _values) const {
+  calc_->fillExtValues(_slimfly, _values);
+  HopCounts counts = hopCounts(_slimfly.width);
+  _values->push_back(diameter(counts));
+  _values->push_back(averageHops(counts));
+}
+
+HopCounts HopCountCalculator::hopCounts(u64 _width) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  std::unordered_map<u64, HopCounts>::const_iterator it =
+      hopCounts_.find(_width);
+  if (it == hopCounts_.end()) {
+    SlimflyGraph graph(_width, SlimflyGraph::deltaOf(_width));
+    it = hopCounts_.insert(std::make_pair(_width, computeHopCounts(
+        graph.offsets(), graph.neighbors(), workPool_))).first;
+  }
+  return it->second;
+}
+
+std::string HopCountCalculator::diameter(const HopCounts& _hopCounts) {
+  return _hopCounts.connected ? std::to_string(_hopCounts.diameter) : "inf";
+}
+
+std::string HopCountCalculator::averageHops(const HopCounts& _hopCounts) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.6f", _hopCounts.averageHops);
+  return buf;
+}
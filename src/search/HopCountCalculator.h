@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_HOPCOUNTCALCULATOR_H_
+#define SEARCH_HOPCOUNTCALCULATOR_H_
+
+#include <prim/prim.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "search/Calculator.h"
+#include "search/Engine.h"
+#include "search/HopCounts.h"
+#include "search/SlimflyBlock.h"
+#include "search/WorkPool.h"
+
+/*
+ * Wraps another calculator and appends the diameter and the average hop
+ * count of the router graph to its extension fields. The costs are the
+ * wrapped calculator's. The all-pairs search is only run for the candidates
+ * that get printed and at most once per width.
+ */
+class HopCountCalculator : public Calculator {
+ public:
+  HopCountCalculator(const Calculator* _calc, WorkPool* _workPool);
+  ~HopCountCalculator();
+
+  f64 cost(const Slimfly& _slimfly) const override;
+  void costs(SlimflyBlock* _block) const override;
+  bool costBounds(SlimflyBlock* _block) const override;
+
+  const std::vector<std::string>& extFields() const override;
+  std::unordered_map<std::string, std::string> extValues(
+      const Slimfly& _slimfly) const override;
+  void fillExtValues(const Slimfly& _slimfly,
+                     std::vector<std::string>* _values) const override;
+
+ private:
+  const Calculator* calc_;
+  WorkPool* workPool_;
+  std::vector<std::string> fields_;
+
+  mutable std::mutex lock_;
+  mutable std::unordered_map<u64, HopCounts> hopCounts_;  // by width
+
+  HopCounts hopCounts(u64 _width) const;
+  static std::string diameter(const HopCounts& _hopCounts);
+  static std::string averageHops(const HopCounts& _hopCounts);
+};
+
+#endif  // SEARCH_HOPCOUNTCALCULATOR_H_
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/HopCounts.h"
+
+#include <algorithm>
+
+static const u64 kWords = 2;  // 64 sources per word
+static const u32 kSources = 64 * kWords;
+
+struct BlockCounts {
+  u64 pairs;  // reached pairs, sources included
+  u64 hops;  // sum of the distances
+  u32 diameter;
+};
+
+static BlockCounts searchBlock(const std::vector<u32>& _offsets,
+                               const std::vector<u32>& _neighbors,
+                               const u32* _sources, u32 _count) {
+  u32 numNodes = _offsets.size() - 1;
+  std::vector<u64> visited(numNodes * kWords, 0);
+  std::vector<u64> frontier(visited.size(), 0);
+  std::vector<u64> next(visited.size(), 0);
+
+  // the bits of the sources that exist in this block
+  u64 full[kWords];
+  for (u32 word = 0; word < kWords; word++) {
+    u32 bits = std::min(64u, _count - std::min(_count, word * 64));
+    full[word] = bits == 64 ? ~0lu : (1lu << bits) - 1;
+  }
+
+  // every source starts at distance 0 from itself
+  for (u32 src = 0; src < _count; src++) {
+    u64 bit = 1lu << (src % 64);
+    visited[_sources[src] * kWords + src / 64] |= bit;
+  }
+
+  /* The first level only needs the few edges of the sources, push their bits
+   * to the neighbors instead of pulling over all edges.
+   */
+  BlockCounts counts = {_count, 0, 0};
+  u64 allPairs = static_cast<u64>(numNodes) * _count;
+  for (u32 src = 0; src < _count; src++) {
+    u32 node = _sources[src];
+    u64 bit = 1lu << (src % 64);
+    for (u32 edge = _offsets[node]; edge < _offsets[node + 1]; edge++) {
+      frontier[_neighbors[edge] * kWords + src / 64] |= bit;
+    }
+  }
+  u64 reached = 0;
+  for (u64 idx = 0; idx < frontier.size(); idx++) {
+    frontier[idx] &= ~visited[idx];
+    visited[idx] |= frontier[idx];
+    reached += __builtin_popcountll(frontier[idx]);
+  }
+  counts.pairs += reached;
+  counts.hops += reached;
+  counts.diameter = reached > 0 ? 1 : 0;
+
+  // then pull the frontier bits of the neighbors, level by level
+  for (u32 level = 2; reached > 0 && counts.pairs < allPairs; level++) {
+    reached = 0;
+    for (u32 node = 0; node < numNodes; node++) {
+      u64* seen = &visited[node * kWords];
+      u64* out = &next[node * kWords];
+      u64 acc[kWords] = {0};
+      bool done = true;
+      for (u32 word = 0; word < kWords; word++) {
+        done = done && seen[word] == full[word];
+      }
+      if (!done) {
+        for (u32 edge = _offsets[node]; edge < _offsets[node + 1]; edge++) {
+          const u64* in = &frontier[_neighbors[edge] * kWords];
+          for (u32 word = 0; word < kWords; word++) {
+            acc[word] |= in[word];
+          }
+        }
+      }
+      for (u32 word = 0; word < kWords; word++) {
+        acc[word] &= ~seen[word];
+        seen[word] |= acc[word];
+        out[word] = acc[word];
+        reached += __builtin_popcountll(acc[word]);
+      }
+    }
+    if (reached == 0) {
+      break;  // the rest is unreachable
+    }
+    counts.pairs += reached;
+    counts.hops += reached * level;
+    counts.diameter = level;
+    frontier.swap(next);
+  }
+  return counts;
+}
+
+static HopCounts summarize(const std::vector<BlockCounts>& _blocks,
+                           u64 _numNodes, u64 _numSources) {
+  u64 pairs = 0;
+  u64 hops = 0;
+  HopCounts hopCounts;
+  hopCounts.diameter = 0;
+  for (const BlockCounts& counts : _blocks) {
+    pairs += counts.pairs;
+    hops += counts.hops;
+    hopCounts.diameter = std::max(hopCounts.diameter, counts.diameter);
+  }
+  hopCounts.connected = pairs == _numNodes * _numSources;
+  pairs -= _numSources;  // the sources themselves
+  hopCounts.averageHops = pairs > 0 ? static_cast<f64>(hops) / pairs : 0.0;
+  return hopCounts;
+}
+
+HopCounts computeHopCounts(const std::vector<u32>& _offsets,
+                           const std::vector<u32>& _neighbors,
+                           WorkPool* _workPool) {
+  u32 numNodes = _offsets.size() - 1;
+  std::vector<u32> sources(numNodes);
+  for (u32 node = 0; node < numNodes; node++) {
+    sources[node] = node;
+  }
+  u32 numBlocks = (numNodes + kSources - 1) / kSources;
+  std::vector<BlockCounts> blocks(numBlocks);
+  _workPool->parallelFor(numBlocks, [&](u64 block) {
+      u32 first = block * kSources;
+      blocks[block] = searchBlock(_offsets, _neighbors, &sources[first],
+                                  std::min(kSources, numNodes - first));
+    });
+  return summarize(blocks, numNodes, numNodes);
+}
+
+HopCounts sampleHopCounts(const std::vector<u32>& _offsets,
+                          const std::vector<u32>& _neighbors,
+                          const std::vector<u32>& _sources) {
+  u32 numSources = _sources.size();
+  std::vector<BlockCounts> blocks;
+  for (u32 first = 0; first < numSources; first += kSources) {
+    blocks.push_back(searchBlock(_offsets, _neighbors, &_sources[first],
+                                 std::min(kSources, numSources - first)));
+  }
+  return summarize(blocks, _offsets.size() - 1, numSources);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_HOPCOUNTS_H_
+#define SEARCH_HOPCOUNTS_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+#include "search/WorkPool.h"
+
+/*
+ * Shortest path statistics of a router graph in CSR form, from a breadth
+ * first search out of every router. The searches run bit-parallel: each
+ * router holds one bit per source of a block of 128 sources, and one level
+ * of all of them is a pass over the edges that ORs the frontier bits of the
+ * neighbors. Newly reached pairs are counted with popcount. Source blocks
+ * run concurrently on the work pool.
+ *
+ * sampleHopCounts() only searches from the given sources, in the calling
+ * thread. Its diameter is the largest eccentricity of those sources, a lower
+ * bound of the true diameter. An undirected graph is connected if and only if
+ * any one source reaches every router, so connected is still exact.
+ */
+struct HopCounts {
+  bool connected;
+  u32 diameter;  // over the reachable pairs if not connected
+  f64 averageHops;  // over all ordered pairs of reachable distinct routers
+};
+
+HopCounts computeHopCounts(const std::vector<u32>& _offsets,
+                           const std::vector<u32>& _neighbors,
+                           WorkPool* _workPool);
+
+HopCounts sampleHopCounts(const std::vector<u32>& _offsets,
+                          const std::vector<u32>& _neighbors,
+                          const std::vector<u32>& _sources);
+
+#endif  // SEARCH_HOPCOUNTS_H_
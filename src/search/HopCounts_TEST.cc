@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/HopCounts.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <utility>
+#include <vector>
+
+#include "search/SlimflyGraph.h"
+#include "search/util.h"
+#include "search/WorkPool.h"
+
+// builds the CSR arrays of an undirected graph from an edge list
+static void makeGraph(u32 _nodes,
+                      const std::vector<std::pair<u32, u32> >& _edges,
+                      std::vector<u32>* _offsets,
+                      std::vector<u32>* _neighbors) {
+  std::vector<std::vector<u32> > lists(_nodes);
+  for (const std::pair<u32, u32>& edge : _edges) {
+    lists[edge.first].push_back(edge.second);
+    lists[edge.second].push_back(edge.first);
+  }
+  _offsets->assign(1, 0);
+  _neighbors->clear();
+  for (const std::vector<u32>& list : lists) {
+    _neighbors->insert(_neighbors->end(), list.begin(), list.end());
+    _offsets->push_back(_neighbors->size());
+  }
+}
+
+TEST(HopCounts, slimfly) {
+  /*
+   * with diameter 2 every router sees its k neighbors at 1 hop and all other
+   *  routers at 2 hops. Widths from 9 on span several source blocks.
+   */
+  WorkPool pool(2);
+  for (u32 width : primePowers(4, 29)) {
+    SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+    HopCounts hopCounts = computeHopCounts(graph.offsets(),
+                                           graph.neighbors(), &pool);
+    f64 nodes = graph.numNodes();
+    f64 degree = graph.degree(0);
+    EXPECT_TRUE(hopCounts.connected) << width;
+    EXPECT_EQ(hopCounts.diameter, 2u) << width;
+    EXPECT_NEAR(hopCounts.averageHops,
+                (degree + 2 * (nodes - 1 - degree)) / (nodes - 1), 1e-12)
+        << width;
+  }
+}
+
+TEST(HopCounts, path) {
+  // a path of n nodes has diameter n-1 and an average distance of (n+1)/3
+  for (u32 nodes : {2u, 3u, 127u, 128u, 129u, 300u}) {
+    std::vector<std::pair<u32, u32> > edges;
+    for (u32 node = 1; node < nodes; node++) {
+      edges.push_back(std::make_pair(node - 1, node));
+    }
+    std::vector<u32> offsets, neighbors;
+    makeGraph(nodes, edges, &offsets, &neighbors);
+    WorkPool pool(3);
+    HopCounts hopCounts = computeHopCounts(offsets, neighbors, &pool);
+    EXPECT_TRUE(hopCounts.connected);
+    EXPECT_EQ(hopCounts.diameter, nodes - 1);
+    EXPECT_NEAR(hopCounts.averageHops, (nodes + 1) / 3.0, 1e-9);
+  }
+}
+
+TEST(HopCounts, disconnected) {
+  // a triangle and a separate edge, distances only count within components
+  std::vector<u32> offsets, neighbors;
+  makeGraph(5, {{0, 1}, {1, 2}, {2, 0}, {3, 4}}, &offsets, &neighbors);
+  WorkPool pool(1);
+  HopCounts hopCounts = computeHopCounts(offsets, neighbors, &pool);
+  EXPECT_FALSE(hopCounts.connected);
+  EXPECT_EQ(hopCounts.diameter, 1u);
+  EXPECT_EQ(hopCounts.averageHops, 1.0);
+
+  HopCounts sampled = sampleHopCounts(offsets, neighbors, {3});
+  EXPECT_FALSE(sampled.connected);
+}
+
+TEST(HopCounts, threads) {
+  SlimflyGraph graph(25, SlimflyGraph::deltaOf(25));
+  WorkPool single(1);
+  HopCounts expected = computeHopCounts(graph.offsets(), graph.neighbors(),
+                                        &single);
+  for (u32 threads : {2u, 4u}) {
+    WorkPool pool(threads);
+    HopCounts hopCounts = computeHopCounts(graph.offsets(),
+                                           graph.neighbors(), &pool);
+    EXPECT_EQ(hopCounts.connected, expected.connected);
+    EXPECT_EQ(hopCounts.diameter, expected.diameter);
+    EXPECT_EQ(hopCounts.averageHops, expected.averageHops);
+  }
+}
+
+TEST(HopCounts, sampled) {
+  // sampling every source is the full search, fewer give a lower bound
+  SlimflyGraph graph(13, SlimflyGraph::deltaOf(13));
+  WorkPool pool(1);
+  HopCounts full = computeHopCounts(graph.offsets(), graph.neighbors(),
+                                    &pool);
+  std::vector<u32> sources;
+  for (u32 node = 0; node < graph.numNodes(); node++) {
+    sources.push_back(node);
+  }
+  HopCounts all = sampleHopCounts(graph.offsets(), graph.neighbors(),
+                                  sources);
+  EXPECT_EQ(all.connected, full.connected);
+  EXPECT_EQ(all.diameter, full.diameter);
+  EXPECT_NEAR(all.averageHops, full.averageHops, 1e-12);
+
+  HopCounts few = sampleHopCounts(graph.offsets(), graph.neighbors(),
+                                  {0, 200});
+  EXPECT_TRUE(few.connected);
+  EXPECT_EQ(few.diameter, 2u);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/JsonlWriter.h"
+
+#include <vector>
+
+JsonlWriter::JsonlWriter(const Calculator* _calc, FILE* _out)
+    : ResultWriter(_calc, _out) {}
+
+JsonlWriter::~JsonlWriter() {}
+
+void JsonlWriter::accepted(const Slimfly& _slimfly) {
+  writeRecord("candidate", 0, _slimfly);
+  fflush(out_);
+}
+
+bool JsonlWriter::allCandidates() const {
+  return true;
+}
+
+void JsonlWriter::finish(const std::deque<Slimfly>& _results) {
+  for (u64 idx = 0; idx < _results.size(); idx++) {
+    writeRecord("result", idx + 1, _results.at(idx));
+  }
+  fflush(out_);
+}
+
+void JsonlWriter::writeRecord(const char* _record, u64 _rank,
+                              const Slimfly& _slimfly) {
+  std::string line = "{\"record\":\"" + std::string(_record) + "\"";
+  if (_rank > 0) {
+    line += ",\"rank\":" + std::to_string(_rank);
+  }
+  line += ",\"dimensions\":" + std::to_string(_slimfly.dimensions) +
+      ",\"width\":" + std::to_string(_slimfly.width) +
+      ",\"concentration\":" + std::to_string(_slimfly.concentration) +
+      ",\"terminals\":" + std::to_string(_slimfly.terminals) +
+      ",\"routers\":" + std::to_string(_slimfly.routers) +
+      ",\"radix\":" + std::to_string(_slimfly.routerRadix) +
+      ",\"channels\":" + std::to_string(_slimfly.channels) +
+      ",\"bisection\":" + real(_slimfly.bisections) +
+      ",\"cost\":" + real(_slimfly.cost);
+
+  const std::vector<std::string>& extFields = calc_->extFields();
+  if (!extFields.empty()) {
+    calc_->fillExtValues(_slimfly, &extValues_);
+    line += ",\"ext\":{";
+    for (u64 ext = 0; ext < extFields.size(); ext++) {
+      const std::string& field = extFields.at(ext);
+      line += (ext > 0 ? ",\"" : "\"") + escape(field) + "\":\"" +
+          escape(extValues_.at(ext)) + "\"";
+    }
+    line += "}";
+  }
+  fprintf(out_, "%s}\n", line.c_str());
+}
+
+std::string JsonlWriter::escape(const std::string& _value) {
+  std::string escaped;
+  for (char c : _value) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<u8>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", static_cast<u32>(c));
+      escaped += buf;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
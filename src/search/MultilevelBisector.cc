@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/MultilevelBisector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <utility>
+
+namespace {
+
+static const u32 kNone = U32_MAX;
+static const u32 kCoarsenTo = 100;
+static const f64 kCoarsenRatio = 0.95;
+static const f64 kImbalance = 1.03;
+static const u32 kInitTries = 8;
+static const u32 kRefinePasses = 10;
+
+struct Graph {
+  u32 nvtxs;
+  u64 tvwgt;
+  std::vector<u32> xadj;
+  std::vector<u32> adjncy;
+  std::vector<u32> adjwgt;
+  std::vector<u32> vwgt;
+  std::vector<u32> cmap;  // fine vertex to coarse vertex
+};
+
+typedef std::mt19937_64 Random;
+
+// balance state of a partition, ordered so that smaller is better
+struct Score {
+  u64 imbalance;
+  u64 cut;
+  bool operator<(const Score& _other) const {
+    return (imbalance < _other.imbalance) ||
+        (imbalance == _other.imbalance && cut < _other.cut);
+  }
+};
+
+void buildFinest(const std::vector<u32>& _offsets,
+                 const std::vector<u32>& _neighbors, Graph* _graph) {
+  _graph->nvtxs = _offsets.size() - 1;
+  _graph->tvwgt = _graph->nvtxs;
+  _graph->xadj = _offsets;
+  _graph->adjncy = _neighbors;
+  _graph->adjwgt.assign(_neighbors.size(), 1);
+  _graph->vwgt.assign(_graph->nvtxs, 1);
+}
+
+u64 maxPartWeight(const Graph& _graph) {
+  return static_cast<u64>(std::ceil((_graph.tvwgt / 2.0) * kImbalance));
+}
+
+u64 imbalance(const u64* _pwgts, u64 _maxPwgt) {
+  u64 heavy = std::max(_pwgts[0], _pwgts[1]);
+  return (heavy > _maxPwgt) ? heavy - _maxPwgt : 0;
+}
+
+u64 computeCut(const Graph& _graph, const std::vector<u8>& _where) {
+  u64 cut = 0;
+  for (u32 v = 0; v < _graph.nvtxs; v++) {
+    for (u32 e = _graph.xadj[v]; e < _graph.xadj[v + 1]; e++) {
+      if (_where[v] != _where[_graph.adjncy[e]]) {
+        cut += _graph.adjwgt[e];
+      }
+    }
+  }
+  return cut / 2;
+}
+
+bool balanced(const Graph& _graph, const std::vector<u8>& _where) {
+  u64 pwgts[2] = {0, 0};
+  for (u32 v = 0; v < _graph.nvtxs; v++) {
+    pwgts[_where[v]] += _graph.vwgt[v];
+  }
+  return imbalance(pwgts, maxPartWeight(_graph)) == 0;
+}
+
+/*
+ * Heavy edge matching. Vertices are visited in random order and each one is
+ *  matched with the unmatched neighbor it shares the heaviest edge with. The
+ *  return value is the number of coarse vertices. _cvtxs receives the pair of
+ *  fine vertices making up each coarse vertex.
+ */
+u32 matchVertices(Graph* _graph, Random* _random,
+                  std::vector<std::pair<u32, u32> >* _cvtxs) {
+  u32 nvtxs = _graph->nvtxs;
+  std::vector<u32> perm(nvtxs);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::shuffle(perm.begin(), perm.end(), *_random);
+
+  u64 maxVwgt = std::max<u64>(1, (3 * _graph->tvwgt) / (2 * kCoarsenTo));
+  std::vector<u32> match(nvtxs, kNone);
+  _graph->cmap.assign(nvtxs, kNone);
+  _cvtxs->clear();
+
+  for (u32 v : perm) {
+    if (match[v] != kNone) {
+      continue;
+    }
+    u32 best = v;
+    u32 bestWgt = 0;
+    for (u32 e = _graph->xadj[v]; e < _graph->xadj[v + 1]; e++) {
+      u32 u = _graph->adjncy[e];
+      if (match[u] == kNone && u != v && _graph->adjwgt[e] > bestWgt &&
+          _graph->vwgt[v] + _graph->vwgt[u] <= maxVwgt) {
+        best = u;
+        bestWgt = _graph->adjwgt[e];
+      }
+    }
+    match[v] = best;
+    match[best] = v;
+    _graph->cmap[v] = _cvtxs->size();
+    _graph->cmap[best] = _cvtxs->size();
+    _cvtxs->push_back(std::make_pair(v, best));
+  }
+  return _cvtxs->size();
+}
+
+/*
+ * Builds the coarse graph from a matching by merging the adjacency of each
+ *  matched pair, summing parallel edges and dropping self loops.
+ */
+void contractGraph(const Graph& _fine,
+                   const std::vector<std::pair<u32, u32> >& _cvtxs,
+                   Graph* _coarse) {
+  u32 ncvtxs = _cvtxs.size();
+  _coarse->nvtxs = ncvtxs;
+  _coarse->tvwgt = _fine.tvwgt;
+  _coarse->xadj.assign(ncvtxs + 1, 0);
+  _coarse->adjncy.clear();
+  _coarse->adjwgt.clear();
+  _coarse->vwgt.assign(ncvtxs, 0);
+  _coarse->adjncy.reserve(_fine.adjncy.size() / 2);
+  _coarse->adjwgt.reserve(_fine.adjncy.size() / 2);
+
+  std::vector<u32> htable(ncvtxs, kNone);
+  for (u32 c = 0; c < ncvtxs; c++) {
+    u32 start = _coarse->adjncy.size();
+    u32 members[2] = {_cvtxs[c].first, _cvtxs[c].second};
+    u32 count = (members[0] == members[1]) ? 1 : 2;
+    for (u32 m = 0; m < count; m++) {
+      u32 v = members[m];
+      _coarse->vwgt[c] += _fine.vwgt[v];
+      for (u32 e = _fine.xadj[v]; e < _fine.xadj[v + 1]; e++) {
+        u32 cu = _fine.cmap[_fine.adjncy[e]];
+        if (cu == c) {
+          continue;
+        }
+        if (htable[cu] == kNone) {
+          htable[cu] = _coarse->adjncy.size();
+          _coarse->adjncy.push_back(cu);
+          _coarse->adjwgt.push_back(_fine.adjwgt[e]);
+        } else {
+          _coarse->adjwgt[htable[cu]] += _fine.adjwgt[e];
+        }
+      }
+    }
+    for (u32 e = start; e < _coarse->adjncy.size(); e++) {
+      htable[_coarse->adjncy[e]] = kNone;
+    }
+    _coarse->xadj[c + 1] = _coarse->adjncy.size();
+  }
+}
+
+/*
+ * Two-way Fiduccia-Mattheyses refinement. Each pass moves vertices one at a
+ *  time in order of decreasing gain, locking them as they move, then rolls
+ *  back to the best balanced cut seen during the pass. Refinement also stops
+ *  once a balanced cut below _threshold is reached.
+ */
+u64 refine(const Graph& _graph, std::vector<u8>* _where, u64 _threshold = 0) {
+  std::vector<u8>& where = *_where;
+  u32 nvtxs = _graph.nvtxs;
+  u64 maxPwgt = maxPartWeight(_graph);
+  u32 limit = std::min<u32>(std::max<u32>(nvtxs / 100, 25), 150);
+
+  std::vector<s64> gain(nvtxs);
+  std::vector<bool> locked(nvtxs, false);
+  std::vector<u32> moved;
+  typedef std::pair<s64, u32> Entry;
+
+  u64 pwgts[2] = {0, 0};
+  u64 cut = 0;
+  for (u32 pass = 0; pass < kRefinePasses; pass++) {
+    // compute the gain of every vertex from scratch
+    pwgts[0] = 0;
+    pwgts[1] = 0;
+    cut = 0;
+    std::priority_queue<Entry> queues[2];
+    for (u32 v = 0; v < nvtxs; v++) {
+      s64 internal = 0;
+      s64 external = 0;
+      for (u32 e = _graph.xadj[v]; e < _graph.xadj[v + 1]; e++) {
+        if (where[_graph.adjncy[e]] == where[v]) {
+          internal += _graph.adjwgt[e];
+        } else {
+          external += _graph.adjwgt[e];
+        }
+      }
+      gain[v] = external - internal;
+      cut += external;
+      pwgts[where[v]] += _graph.vwgt[v];
+      if (external > 0) {
+        queues[where[v]].push(Entry(gain[v], v));
+      }
+    }
+    cut /= 2;
+
+    Score start = {imbalance(pwgts, maxPwgt), cut};
+    Score best = start;
+    u32 bestMoves = 0;
+    moved.clear();
+
+    while (true) {
+      // choose the side to move from, forced when out of balance
+      s32 from = -1;
+      if (pwgts[0] > maxPwgt) {
+        from = 0;
+      } else if (pwgts[1] > maxPwgt) {
+        from = 1;
+      }
+
+      // discard stale queue entries
+      for (u32 side = 0; side < 2; side++) {
+        while (!queues[side].empty()) {
+          const Entry& top = queues[side].top();
+          if (locked[top.second] || where[top.second] != side ||
+              gain[top.second] != top.first) {
+            queues[side].pop();
+          } else {
+            break;
+          }
+        }
+      }
+      if (from < 0) {
+        if (queues[0].empty() && queues[1].empty()) {
+          break;
+        } else if (queues[0].empty()) {
+          from = 1;
+        } else if (queues[1].empty()) {
+          from = 0;
+        } else {
+          from = (queues[0].top().first >= queues[1].top().first) ? 0 : 1;
+        }
+      }
+      if (queues[from].empty()) {
+        break;
+      }
+
+      u32 v = queues[from].top().second;
+      queues[from].pop();
+      u32 to = 1 - from;
+      locked[v] = true;
+      if (pwgts[from] <= maxPwgt && pwgts[to] + _graph.vwgt[v] > maxPwgt) {
+        // moving this vertex would break the balance
+        continue;
+      }
+
+      // move the vertex and update its neighbors
+      cut -= gain[v];
+      pwgts[from] -= _graph.vwgt[v];
+      pwgts[to] += _graph.vwgt[v];
+      where[v] = to;
+      gain[v] = -gain[v];
+      moved.push_back(v);
+      for (u32 e = _graph.xadj[v]; e < _graph.xadj[v + 1]; e++) {
+        u32 u = _graph.adjncy[e];
+        s64 delta = 2 * static_cast<s64>(_graph.adjwgt[e]);
+        gain[u] += (where[u] == to) ? -delta : delta;
+        if (!locked[u]) {
+          queues[where[u]].push(Entry(gain[u], u));
+        }
+      }
+
+      Score current = {imbalance(pwgts, maxPwgt), cut};
+      if (current < best) {
+        best = current;
+        bestMoves = moved.size();
+      } else if (moved.size() - bestMoves > limit) {
+        break;
+      }
+    }
+
+    // roll back to the best partition of this pass
+    for (u32 idx = moved.size(); idx > bestMoves; idx--) {
+      u32 v = moved[idx - 1];
+      where[v] = 1 - where[v];
+    }
+    for (u32 v = 0; v < nvtxs; v++) {
+      locked[v] = false;
+    }
+    cut = best.cut;
+    if (bestMoves == 0 || (best.imbalance == 0 && best.cut < _threshold)) {
+      break;
+    }
+  }
+  return cut;
+}
+
+/*
+ * Greedy graph growing. A region is grown breadth first from a random vertex
+ *  until it holds half of the vertex weight, then the result is refined. The
+ *  best of several tries is kept.
+ */
+u64 initialPartition(const Graph& _graph, Random* _random,
+                     std::vector<u8>* _where) {
+  u32 nvtxs = _graph.nvtxs;
+  u64 maxPwgt = maxPartWeight(_graph);
+  u64 target = _graph.tvwgt / 2;
+  std::uniform_int_distribution<u32> pick(0, nvtxs - 1);
+
+  Score best = {U64_MAX, U64_MAX};
+  std::vector<u8> where(nvtxs);
+  std::vector<u32> queue(nvtxs);
+  for (u32 attempt = 0; attempt < kInitTries; attempt++) {
+    where.assign(nvtxs, 1);
+    u64 pwgts[2] = {0, _graph.tvwgt};
+    u32 head = 0;
+    u32 tail = 0;
+    u32 grown = 0;
+    while (pwgts[0] < target && grown < nvtxs) {
+      if (head == tail) {
+        // start (or restart on a disconnected graph) from a random vertex
+        u32 seed = pick(*_random);
+        while (where[seed] == 0) {
+          seed = (seed + 1) % nvtxs;
+        }
+        where[seed] = 0;
+        queue[tail++] = seed;
+        grown++;
+        pwgts[0] += _graph.vwgt[seed];
+        pwgts[1] -= _graph.vwgt[seed];
+        continue;
+      }
+      u32 v = queue[head++];
+      for (u32 e = _graph.xadj[v]; e < _graph.xadj[v + 1]; e++) {
+        u32 u = _graph.adjncy[e];
+        if (where[u] == 1 && pwgts[0] + _graph.vwgt[u] <= maxPwgt &&
+            pwgts[0] < target) {
+          where[u] = 0;
+          queue[tail++] = u;
+          grown++;
+          pwgts[0] += _graph.vwgt[u];
+          pwgts[1] -= _graph.vwgt[u];
+        }
+      }
+    }
+
+    u64 cut = refine(_graph, &where);
+    u64 counts[2] = {0, 0};
+    for (u32 v = 0; v < nvtxs; v++) {
+      counts[where[v]] += _graph.vwgt[v];
+    }
+    Score score = {imbalance(counts, maxPwgt), cut};
+    if (score < best) {
+      best = score;
+      *_where = where;
+    }
+  }
+  return best.cut;
+}
+
+}  // namespace
+
+MultilevelBisector::MultilevelBisector(u64 _seed)
+    : seed_(_seed) {}
+
+MultilevelBisector::~MultilevelBisector() {}
+
+std::string MultilevelBisector::settings() const {
+  return "multilevel seed=" + std::to_string(seed_);
+}
+
+f64 MultilevelBisector::imbalance() const {
+  return kImbalance;
+}
+
+Bisector::Decision MultilevelBisector::partition(
+    const std::vector<u32>& _offsets, const std::vector<u32>& _neighbors,
+    u64 _trial, u64 _threshold, std::vector<u8>* _where) const {
+  Decision decision = {0, true};
+  if (_offsets.size() < 3) {
+    if (_where) {
+      _where->assign(_offsets.size() - 1, 0);
+    }
+    return decision;
+  }
+  Random random(trialSeed(seed_, _trial));
+
+  // build the finest level with unit weights
+  std::vector<Graph> levels(1);
+  buildFinest(_offsets, _neighbors, &levels.front());
+
+  // coarsen until the graph is small or stops shrinking
+  std::vector<std::pair<u32, u32> > cvtxs;
+  while (levels.back().nvtxs > kCoarsenTo) {
+    u32 ncvtxs = matchVertices(&levels.back(), &random, &cvtxs);
+    if (ncvtxs > kCoarsenRatio * levels.back().nvtxs) {
+      break;
+    }
+    levels.push_back(Graph());
+    contractGraph(levels[levels.size() - 2], cvtxs, &levels.back());
+  }
+
+  /* Split the coarsest graph. Projection keeps both the cut and the part
+   * weights, so the partition of every level is also a cut of the finest
+   * graph and decision mode can stop at any level.
+   */
+  std::vector<u8> where;
+  decision.edgeCut = initialPartition(levels.back(), &random, &where);
+  if (decision.edgeCut < _threshold && balanced(levels.back(), where)) {
+    decision.complete = false;
+    return decision;
+  }
+
+  // project the partition back to the finest graph, refining at each level
+  for (u32 level = levels.size() - 1; level > 0; level--) {
+    const Graph& fine = levels[level - 1];
+    std::vector<u8> fineWhere(fine.nvtxs);
+    for (u32 v = 0; v < fine.nvtxs; v++) {
+      fineWhere[v] = where[fine.cmap[v]];
+    }
+    where.swap(fineWhere);
+    levels.pop_back();
+    decision.edgeCut = refine(levels.back(), &where, _threshold);
+    if (decision.edgeCut < _threshold && balanced(levels.back(), where)) {
+      decision.complete = false;
+      return decision;
+    }
+  }
+
+  decision.edgeCut = computeCut(levels.front(), where);
+  if (_where) {
+    _where->swap(where);
+  }
+  return decision;
+}
+
+u64 MultilevelBisector::edgeCut(const std::vector<u32>& _offsets,
+                                const std::vector<u32>& _neighbors,
+                                u64 _trial) const {
+  return partition(_offsets, _neighbors, _trial, 0, nullptr).edgeCut;
+}
+
+Bisector::Decision MultilevelBisector::cutBelow(
+    const std::vector<u32>& _offsets, const std::vector<u32>& _neighbors,
+    u64 _trial, u64 _threshold) const {
+  return partition(_offsets, _neighbors, _trial, _threshold, nullptr);
+}
+
+u64 MultilevelBisector::split(const std::vector<u32>& _offsets,
+                              const std::vector<u32>& _neighbors,
+                              u64 _trial, std::vector<u8>* _where) const {
+  return partition(_offsets, _neighbors, _trial, 0, _where).edgeCut;
+}
+
+u64 MultilevelBisector::refinePartition(const std::vector<u32>& _offsets,
+                                        const std::vector<u32>& _neighbors,
+                                        std::vector<u8>* _where) const {
+  // Fiduccia-Mattheyses passes on the finest level only
+  if (_offsets.size() < 3) {
+    return 0;
+  }
+  Graph graph;
+  buildFinest(_offsets, _neighbors, &graph);
+  return refine(graph, _where);
+}
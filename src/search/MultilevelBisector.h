@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_MULTILEVELBISECTOR_H_
+#define SEARCH_MULTILEVELBISECTOR_H_
+
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "search/Bisector.h"
+
+/*
+ * This is a built-in multilevel graph bisector in the style of METIS. The
+ * graph is coarsened with heavy edge matching, the coarsest graph is split by
+ * greedy graph growing, then the partition is projected back up and refined
+ * with Fiduccia-Mattheyses passes at every level. The balance tolerance
+ * matches the gpmetis default (3%). In decision mode the partition of every
+ * level is checked against the threshold, so a clearly small cut is usually
+ * found on a coarse level after a few refinement passes.
+ */
+class MultilevelBisector : public Bisector {
+ public:
+  explicit MultilevelBisector(u64 _seed);
+  ~MultilevelBisector();
+  u64 edgeCut(const std::vector<u32>& _offsets,
+              const std::vector<u32>& _neighbors,
+              u64 _trial) const override;
+  Decision cutBelow(const std::vector<u32>& _offsets,
+                    const std::vector<u32>& _neighbors, u64 _trial,
+                    u64 _threshold) const override;
+  u64 split(const std::vector<u32>& _offsets,
+            const std::vector<u32>& _neighbors, u64 _trial,
+            std::vector<u8>* _where) const override;
+  u64 refinePartition(const std::vector<u32>& _offsets,
+                      const std::vector<u32>& _neighbors,
+                      std::vector<u8>* _where) const override;
+  std::string settings() const override;
+  f64 imbalance() const override;
+
+ private:
+  Decision partition(const std::vector<u32>& _offsets,
+                     const std::vector<u32>& _neighbors, u64 _trial,
+                     u64 _threshold, std::vector<u8>* _where) const;
+
+  u64 seed_;
+};
+
+#endif  // SEARCH_MULTILEVELBISECTOR_H_
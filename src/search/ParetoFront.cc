@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/ParetoFront.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+ParetoFront::ParetoFront(const std::string& _objectives) {
+  std::string::size_type start = 0;
+  while (start <= _objectives.size()) {
+    std::string::size_type end = _objectives.find(',', start);
+    if (end == std::string::npos) {
+      end = _objectives.size();
+    }
+    std::string name = _objectives.substr(start, end - start);
+    start = end + 1;
+
+    Objective objective;
+    if (name == "routers") {
+      objective = {Field::kRouters, 1};
+    } else if (name == "channels") {
+      objective = {Field::kChannels, 1};
+    } else if (name == "radix") {
+      objective = {Field::kRadix, 1};
+    } else if (name == "width") {
+      objective = {Field::kWidth, 1};
+    } else if (name == "cost") {
+      objective = {Field::kCost, 1};
+    } else if (name == "terminals") {
+      objective = {Field::kTerminals, -1};
+    } else if (name == "concentration") {
+      objective = {Field::kConcentration, -1};
+    } else if (name == "bisection") {
+      objective = {Field::kBisection, -1};
+    } else {
+      throw std::runtime_error("unknown pareto objective: " + name);
+    }
+    objectives_.push_back(objective);
+  }
+}
+
+ParetoFront::~ParetoFront() {}
+
+void ParetoFront::accepted(const Slimfly& _slimfly) {
+  Point point = {key(_slimfly), _slimfly};
+
+  if (objectives_.size() == 2) {
+    /* The staircase is ordered by the first objective with the second one
+     * strictly decreasing. The point before the new one has the largest
+     * first value not above it and the smallest second value of all those,
+     * it alone decides if the new point is dominated. The points the new one
+     * dominates follow it in a contiguous run.
+     */
+    f64 x = point.key[0];
+    f64 y = point.key[1];
+    std::map<f64, Point>::iterator it = staircase_.upper_bound(x);
+    if (it != staircase_.begin() && std::prev(it)->second.key[1] <= y) {
+      return;
+    }
+    it = staircase_.lower_bound(x);
+    while (it != staircase_.end() && it->second.key[1] >= y) {
+      it = staircase_.erase(it);
+    }
+    staircase_.emplace_hint(it, x, point);
+    return;
+  }
+
+  for (const Point& other : points_) {
+    if (weaklyDominates(other.key, point.key)) {
+      return;
+    }
+  }
+  points_.erase(std::remove_if(points_.begin(), points_.end(),
+                               [&](const Point& _other) {
+                                 return weaklyDominates(point.key,
+                                                        _other.key);
+                               }),
+                points_.end());
+  points_.push_back(point);
+}
+
+u64 ParetoFront::size() const {
+  return staircase_.size() + points_.size();
+}
+
+std::deque<Slimfly> ParetoFront::frontier() const {
+  std::vector<const Point*> sorted;
+  for (const std::pair<const f64, Point>& entry : staircase_) {
+    sorted.push_back(&entry.second);
+  }
+  for (const Point& point : points_) {
+    sorted.push_back(&point);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const Point* _lhs, const Point* _rhs) {
+              return _lhs->key < _rhs->key;
+            });
+  std::deque<Slimfly> frontier;
+  for (const Point* point : sorted) {
+    frontier.push_back(point->slimfly);
+  }
+  return frontier;
+}
+
+std::vector<f64> ParetoFront::key(const Slimfly& _slimfly) const {
+  std::vector<f64> key(objectives_.size());
+  for (u64 idx = 0; idx < objectives_.size(); idx++) {
+    f64 value = 0;
+    switch (objectives_[idx].field) {
+      case Field::kRouters:
+        value = _slimfly.routers;
+        break;
+      case Field::kChannels:
+        value = _slimfly.channels;
+        break;
+      case Field::kRadix:
+        value = _slimfly.routerRadix;
+        break;
+      case Field::kWidth:
+        value = _slimfly.width;
+        break;
+      case Field::kCost:
+        value = _slimfly.cost;
+        break;
+      case Field::kTerminals:
+        value = _slimfly.terminals;
+        break;
+      case Field::kConcentration:
+        value = _slimfly.concentration;
+        break;
+      case Field::kBisection:
+        value = _slimfly.bisections;
+        break;
+    }
+    key[idx] = objectives_[idx].sign * value;
+  }
+  return key;
+}
+
+bool ParetoFront::weaklyDominates(const std::vector<f64>& _lhs,
+                                  const std::vector<f64>& _rhs) {
+  for (u64 idx = 0; idx < _lhs.size(); idx++) {
+    if (_lhs[idx] > _rhs[idx]) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_PARETOFRONT_H_
+#define SEARCH_PARETOFRONT_H_
+
+#include <prim/prim.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "search/Engine.h"
+
+/*
+ * Keeps the accepted candidates of an engine run that no other candidate
+ * dominates over a list of objectives. Objectives are Slimfly fields with a
+ * natural direction: routers, channels, radix, width and cost are minimized,
+ * terminals, concentration and bisection are maximized. A candidate dominates
+ * another if it is at least as good in every objective; of equal candidates
+ * the first one found is kept.
+ *
+ * With two objectives the front is a staircase ordered by the first one, an
+ * insertion costs O(log n) plus the points it removes. Otherwise each
+ * insertion scans the current front.
+ */
+class ParetoFront : public ResultListener {
+ public:
+  // _objectives is a comma separated list of objective names
+  explicit ParetoFront(const std::string& _objectives);
+  ~ParetoFront();
+  void accepted(const Slimfly& _slimfly) override;
+
+  u64 size() const;
+
+  // the front ordered by the first objective, then the next, and so on
+  std::deque<Slimfly> frontier() const;
+
+ private:
+  enum class Field {
+    kRouters, kChannels, kRadix, kWidth, kCost, kTerminals, kConcentration,
+    kBisection
+  };
+  struct Objective {
+    Field field;
+    f64 sign;  // 1 to minimize, -1 to maximize
+  };
+  struct Point {
+    std::vector<f64> key;  // objective values, all to be minimized
+    Slimfly slimfly;
+  };
+
+  std::vector<Objective> objectives_;
+  std::map<f64, Point> staircase_;  // two objectives, keyed by the first
+  std::vector<Point> points_;  // any other number of objectives
+
+  std::vector<f64> key(const Slimfly& _slimfly) const;
+  static bool weaklyDominates(const std::vector<f64>& _lhs,
+                              const std::vector<f64>& _rhs);
+};
+
+#endif  // SEARCH_PARETOFRONT_H_
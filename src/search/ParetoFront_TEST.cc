@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/ParetoFront.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// the dimensions field tags a candidate, it is not an objective
+static Slimfly makeSlimfly(u64 _tag, u64 _routers, u64 _terminals) {
+  Slimfly slimfly = {_tag, 5, _routers, 1, _terminals, 0, 0.0, 0, 0.0};
+  return slimfly;
+}
+
+static std::vector<u64> tags(const ParetoFront& _front) {
+  std::vector<u64> tags;
+  for (const Slimfly& slimfly : _front.frontier()) {
+    tags.push_back(slimfly.dimensions);
+  }
+  return tags;
+}
+
+TEST(ParetoFront, dominance) {
+  // the width objective is the same for all, the front takes the generic
+  //  path but must agree with the staircase
+  for (const char* objectives : {"routers,terminals",
+                                 "routers,terminals,width"}) {
+    ParetoFront front(objectives);
+    front.accepted(makeSlimfly(0, 10, 100));
+    front.accepted(makeSlimfly(1, 10, 120));  // equal x, replaces 0
+    front.accepted(makeSlimfly(2, 10, 120));  // equal to 1, first one kept
+    front.accepted(makeSlimfly(3, 10, 90));  // equal x, dominated by 1
+    front.accepted(makeSlimfly(4, 8, 50));
+    front.accepted(makeSlimfly(5, 12, 200));
+    front.accepted(makeSlimfly(6, 9, 120));  // replaces 1
+    front.accepted(makeSlimfly(7, 12, 150));  // equal x, dominated by 5
+    front.accepted(makeSlimfly(8, 11, 60));  // dominated by 6
+    EXPECT_EQ(front.size(), 3u);
+    EXPECT_EQ(tags(front), std::vector<u64>({4, 6, 5}));
+  }
+}
+
+TEST(ParetoFront, bruteForce) {
+  // small value ranges force many ties in either objective
+  std::mt19937_64 random(7);
+  std::uniform_int_distribution<u64> value(0, 15);
+  for (u32 round = 0; round < 50; round++) {
+    std::vector<Slimfly> all;
+    for (u64 tag = 0; tag < 100; tag++) {
+      all.push_back(makeSlimfly(tag, value(random), value(random)));
+    }
+
+    ParetoFront staircase("routers,terminals");
+    ParetoFront generic("routers,terminals,width");
+    for (const Slimfly& slimfly : all) {
+      staircase.accepted(slimfly);
+      generic.accepted(slimfly);
+    }
+
+    // kept unless strictly dominated or equal to an earlier candidate
+    std::vector<Slimfly> expected;
+    for (u64 idx = 0; idx < all.size(); idx++) {
+      bool kept = true;
+      for (u64 other = 0; other < all.size() && kept; other++) {
+        bool weak = all[other].routers <= all[idx].routers &&
+            all[other].terminals >= all[idx].terminals;
+        bool equal = all[other].routers == all[idx].routers &&
+            all[other].terminals == all[idx].terminals;
+        if (weak && (!equal || other < idx)) {
+          kept = false;
+        }
+      }
+      if (kept) {
+        expected.push_back(all[idx]);
+      }
+    }
+    std::sort(expected.begin(), expected.end(),
+              [](const Slimfly& _lhs, const Slimfly& _rhs) {
+                return _lhs.routers < _rhs.routers;
+              });
+    std::vector<u64> expectedTags;
+    for (const Slimfly& slimfly : expected) {
+      expectedTags.push_back(slimfly.dimensions);
+    }
+
+    EXPECT_EQ(tags(staircase), expectedTags);
+    EXPECT_EQ(tags(generic), expectedTags);
+  }
+}
+
+TEST(ParetoFront, objectives) {
+  EXPECT_THROW(ParetoFront("routers,speed"), std::runtime_error);
+  EXPECT_THROW(ParetoFront("routers,"), std::runtime_error);
+}
@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/QueryServer.h"
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+
+#include "search/CalculatorFactory.h"
+#include "search/Engine.h"
+#include "search/JsonlWriter.h"
+
+namespace {
+
+struct JsonValue {
+  std::string text;  // raw JSON text of the value
+  std::string string;  // decoded contents when isString
+  bool isString;
+};
+
+typedef std::unordered_map<std::string, JsonValue> JsonObject;
+
+// parses a JSON string starting at the opening quote
+bool parseString(const std::string& _line, u64* _pos, std::string* _out) {
+  u64 pos = *_pos + 1;
+  _out->clear();
+  while (pos < _line.size() && _line[pos] != '"') {
+    char c = _line[pos++];
+    if (c != '\\') {
+      *_out += c;
+      continue;
+    }
+    if (pos >= _line.size()) {
+      return false;
+    }
+    c = _line[pos++];
+    switch (c) {
+      case '"': case '\\': case '/': *_out += c; break;
+      case 'b': *_out += '\b'; break;
+      case 'f': *_out += '\f'; break;
+      case 'n': *_out += '\n'; break;
+      case 'r': *_out += '\r'; break;
+      case 't': *_out += '\t'; break;
+      case 'u': {
+        if (pos + 4 > _line.size()) {
+          return false;
+        }
+        u32 code = strtoul(_line.substr(pos, 4).c_str(), nullptr, 16);
+        pos += 4;
+        // keys and values of interest are ASCII, keep the rest as UTF-8
+        if (code < 0x80) {
+          *_out += static_cast<char>(code);
+        } else if (code < 0x800) {
+          *_out += static_cast<char>(0xC0 | (code >> 6));
+          *_out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+          *_out += static_cast<char>(0xE0 | (code >> 12));
+          *_out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+          *_out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        break;
+      }
+      default: return false;
+    }
+  }
+  if (pos >= _line.size()) {
+    return false;
+  }
+  *_pos = pos + 1;
+  return true;
+}
+
+// whether _text is a JSON number: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isNumber(const std::string& _text) {
+  u64 pos = 0;
+  u64 size = _text.size();
+  if (pos < size && _text[pos] == '-') {
+    pos++;
+  }
+  if (pos < size && _text[pos] == '0') {
+    pos++;
+  } else if (pos < size && isdigit(_text[pos])) {
+    while (pos < size && isdigit(_text[pos])) {
+      pos++;
+    }
+  } else {
+    return false;
+  }
+  if (pos < size && _text[pos] == '.') {
+    pos++;
+    if (pos >= size || !isdigit(_text[pos])) {
+      return false;
+    }
+    while (pos < size && isdigit(_text[pos])) {
+      pos++;
+    }
+  }
+  if (pos < size && (_text[pos] == 'e' || _text[pos] == 'E')) {
+    pos++;
+    if (pos < size && (_text[pos] == '+' || _text[pos] == '-')) {
+      pos++;
+    }
+    if (pos >= size || !isdigit(_text[pos])) {
+      return false;
+    }
+    while (pos < size && isdigit(_text[pos])) {
+      pos++;
+    }
+  }
+  return pos == size;
+}
+
+void skipSpace(const std::string& _line, u64* _pos) {
+  while (*_pos < _line.size() && isspace(_line[*_pos])) {
+    (*_pos)++;
+  }
+}
+
+// parses a flat JSON object whose values are strings, numbers, or literals
+bool parseObject(const std::string& _line, JsonObject* _object) {
+  u64 pos = 0;
+  skipSpace(_line, &pos);
+  if (pos >= _line.size() || _line[pos] != '{') {
+    return false;
+  }
+  pos++;
+  skipSpace(_line, &pos);
+  if (pos < _line.size() && _line[pos] == '}') {
+    pos++;
+  } else {
+    while (true) {
+      std::string key;
+      skipSpace(_line, &pos);
+      if (pos >= _line.size() || _line[pos] != '"' ||
+          !parseString(_line, &pos, &key)) {
+        return false;
+      }
+      skipSpace(_line, &pos);
+      if (pos >= _line.size() || _line[pos] != ':') {
+        return false;
+      }
+      pos++;
+      skipSpace(_line, &pos);
+      if (pos >= _line.size()) {
+        return false;
+      }
+      JsonValue value;
+      u64 start = pos;
+      if (_line[pos] == '"') {
+        if (!parseString(_line, &pos, &value.string)) {
+          return false;
+        }
+        value.isString = true;
+      } else {
+        while (pos < _line.size() && (isalnum(_line[pos]) ||
+                                      strchr("+-.", _line[pos]) != nullptr)) {
+          pos++;
+        }
+        value.isString = false;
+      }
+      value.text = _line.substr(start, pos - start);
+
+      // anything else would be echoed as invalid JSON in the id
+      if (!value.isString && value.text != "true" && value.text != "false" &&
+          value.text != "null" && !isNumber(value.text)) {
+        return false;
+      }
+      (*_object)[key] = value;
+      skipSpace(_line, &pos);
+      if (pos < _line.size() && _line[pos] == ',') {
+        pos++;
+      } else if (pos < _line.size() && _line[pos] == '}') {
+        pos++;
+        break;
+      } else {
+        return false;
+      }
+    }
+  }
+  skipSpace(_line, &pos);
+  return pos == _line.size();
+}
+
+bool getUnsigned(const JsonObject& _object, const char* _key, u64* _value) {
+  JsonObject::const_iterator it = _object.find(_key);
+  if (it == _object.end()) {
+    return true;
+  }
+  const std::string& text = it->second.text;
+  char* end;
+  errno = 0;
+  u64 value = strtoull(text.c_str(), &end, 10);
+  if (it->second.isString || text.empty() || text[0] == '-' || *end != '\0' ||
+      errno != 0) {
+    return false;
+  }
+  *_value = value;
+  return true;
+}
+
+bool getReal(const JsonObject& _object, const char* _key, f64* _value) {
+  JsonObject::const_iterator it = _object.find(_key);
+  if (it == _object.end()) {
+    return true;
+  }
+  const std::string& text = it->second.text;
+  char* end;
+  f64 value = strtod(text.c_str(), &end);
+  if (it->second.isString || text.empty() || *end != '\0') {
+    return false;
+  }
+  *_value = value;
+  return true;
+}
+
+std::string quote(const std::string& _value) {
+  std::string quoted = "\"";
+  for (char c : _value) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+    } else if (static_cast<u8>(c) < 0x20) {
+      quoted += ' ';
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+void writeError(FILE* _out, const std::string& _id,
+                const std::string& _message) {
+  fprintf(_out, "{\"record\":\"error\"%s%s,\"message\":%s}\n",
+          _id.empty() ? "" : ",\"id\":", _id.c_str(),
+          quote(_message).c_str());
+  fflush(_out);
+}
+
+}  // namespace
+
+QueryServer::QueryServer(const SearchQuery& _defaults,
+                         const Bisector* _bisector,
+                         BisectionCache* _bisectionCache,
+                         WorkPool* _workPool)
+    : defaults_(_defaults),
+      bisector_(_bisector),
+      bisectionCache_(_bisectionCache),
+      workPool_(_workPool) {}
+
+QueryServer::~QueryServer() {
+  for (auto& entry : calculators_) {
+    delete entry.second;
+  }
+}
+
+void QueryServer::serve(FILE* _in, FILE* _out) {
+  char* line = nullptr;
+  size_t capacity = 0;
+  ssize_t length;
+  while ((length = getline(&line, &capacity, _in)) >= 0) {
+    std::string query(line, length);
+    while (!query.empty() && isspace(query.back())) {
+      query.pop_back();
+    }
+    if (!query.empty()) {
+      answer(query, _out);
+    }
+  }
+  free(line);
+}
+
+void QueryServer::listen(const std::string& _socketPath) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (_socketPath.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("socket path is too long: " + _socketPath);
+  }
+  strcpy(address.sun_path, _socketPath.c_str());
+
+  // a socket left behind by an earlier server is replaced
+  struct stat info;
+  if (stat(_socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+    unlink(_socketPath.c_str());
+  }
+
+  s32 server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0 ||
+      bind(server, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) != 0 ||
+      ::listen(server, 16) != 0) {
+    throw std::runtime_error("unable to listen on socket: " + _socketPath);
+  }
+
+  // a client that disconnects early must not kill the server
+  signal(SIGPIPE, SIG_IGN);
+
+  while (true) {
+    s32 client = accept(server, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+    FILE* in = fdopen(client, "r");
+    FILE* out = fdopen(dup(client), "w");
+    if (in != nullptr && out != nullptr) {
+      serve(in, out);
+    }
+    if (out != nullptr) {
+      fclose(out);
+    }
+    if (in != nullptr) {
+      fclose(in);
+    } else {
+      close(client);
+    }
+  }
+}
+
+void QueryServer::answer(const std::string& _line, FILE* _out) {
+  JsonObject object;
+  if (!parseObject(_line, &object)) {
+    writeError(_out, "", "query is not a flat JSON object");
+    return;
+  }
+
+  // the id is echoed verbatim
+  std::string id;
+  JsonObject::const_iterator it = object.find("id");
+  if (it != object.end()) {
+    id = it->second.text;
+  }
+
+  SearchQuery query = defaults_;
+  it = object.find("costcalc");
+  if (it != object.end()) {
+    if (!it->second.isString) {
+      writeError(_out, id, "costcalc must be a string");
+      return;
+    }
+    query.costCalc = it->second.string;
+  }
+  static const char* kUnsigned[] = {
+    "minradix", "maxradix", "minconcentration", "maxconcentration",
+    "minterminals", "maxterminals", "maxresults", "bisectiontrials"};
+  u64* fields[] = {
+    &query.minRadix, &query.maxRadix, &query.minConcentration,
+    &query.maxConcentration, &query.minTerminals, &query.maxTerminals,
+    &query.maxResults, &query.bisectionTrials};
+  if (object.count("minterminals") > 0 && object.count("maxterminals") == 0) {
+    query.maxTerminals = 0;
+  }
+  for (u32 idx = 0; idx < sizeof(fields) / sizeof(fields[0]); idx++) {
+    if (!getUnsigned(object, kUnsigned[idx], fields[idx])) {
+      writeError(_out, id, std::string(kUnsigned[idx]) +
+                 " must be a non-negative integer");
+      return;
+    }
+  }
+  if (!getReal(object, "minbandwidth", &query.minBandwidth)) {
+    writeError(_out, id, "minbandwidth must be a number");
+    return;
+  }
+  if (query.bisectionTrials > U32_MAX) {
+    writeError(_out, id, "bisectiontrials must be at most " +
+               std::to_string(U32_MAX));
+    return;
+  }
+  if (query.maxTerminals == 0) {
+    if (query.minTerminals > U64_MAX / 2) {
+      writeError(_out, id, "maxterminals must be given when minterminals "
+                 "is too large to double");
+      return;
+    }
+    query.maxTerminals = query.minTerminals * 2;
+  }
+
+  const Calculator* calc = calculator(query.costCalc);
+  if (calc == nullptr) {
+    writeError(_out, id, "unknown cost calculator: " + query.costCalc);
+    return;
+  }
+
+  try {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    Engine engine(
+        query.minRadix, query.maxRadix, query.minConcentration,
+        query.maxConcentration, query.minTerminals, query.maxTerminals,
+        query.minBandwidth, query.maxResults, calc, bisector_,
+        query.bisectionTrials, bisectionCache_, workPool_);
+    engine.run();
+    const std::deque<Slimfly>& results = engine.results();
+    f64 seconds = std::chrono::duration<f64>(
+        std::chrono::steady_clock::now() - start).count();
+
+    fprintf(_out, "{\"record\":\"query\"%s%s}\n",
+            id.empty() ? "" : ",\"id\":", id.c_str());
+    JsonlWriter writer(calc, _out);
+    writer.finish(results);
+    fprintf(_out, "{\"record\":\"done\"%s%s,\"results\":%lu,"
+            "\"seconds\":%f,\"stats\":%s}\n",
+            id.empty() ? "" : ",\"id\":", id.c_str(), results.size(),
+            seconds, engine.stats().json().c_str());
+    fflush(_out);
+  } catch (std::runtime_error& e) {
+    writeError(_out, id, e.what());
+  }
+}
+
+const Calculator* QueryServer::calculator(const std::string& _type) {
+  std::unordered_map<std::string, Calculator*>::iterator it =
+      calculators_.find(_type);
+  if (it != calculators_.end()) {
+    return it->second;
+  }
+  Calculator* calc = CalculatorFactory::tryCreateCalculator(_type);
+  if (calc != nullptr) {
+    calculators_[_type] = calc;
+  }
+  return calc;
+}
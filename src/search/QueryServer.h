@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_QUERYSERVER_H_
+#define SEARCH_QUERYSERVER_H_
+
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "search/BisectionCache.h"
+#include "search/Bisector.h"
+#include "search/Calculator.h"
+#include "search/WorkPool.h"
+
+// the Engine settings a query may change
+struct SearchQuery {
+  u64 minRadix;
+  u64 maxRadix;
+  u64 minConcentration;
+  u64 maxConcentration;
+  u64 minTerminals;
+  u64 maxTerminals;  // 0 means twice minTerminals
+  f64 minBandwidth;
+  u64 maxResults;
+  std::string costCalc;
+  u64 bisectionTrials;
+};
+
+/*
+ * Answers search queries for as long as the process lives so that the
+ * bisection cache, Galois fields, and cost calculators stay warm between
+ * queries. Every query is one JSON object per line holding any of the keys
+ * minradix, maxradix, minconcentration, maxconcentration, minterminals,
+ * maxterminals, minbandwidth, maxresults, bisectiontrials, costcalc, and id.
+ * Missing keys take the server's defaults. Each answer is a "query" record,
+ * the ranked "result" records in the jsonl output format, and a closing "done"
+ * record with the search statistics. A bad query is answered with a single
+ * "error" record instead. The id, if given, is echoed in the query, done, and
+ * error records.
+ */
+class QueryServer {
+ public:
+  QueryServer(const SearchQuery& _defaults, const Bisector* _bisector,
+              BisectionCache* _bisectionCache, WorkPool* _workPool);
+  ~QueryServer();
+
+  // answers the queries read from _in until end of file
+  void serve(FILE* _in, FILE* _out);
+
+  // accepts connections on a Unix domain socket one at a time, forever
+  void listen(const std::string& _socketPath);
+
+ private:
+  void answer(const std::string& _line, FILE* _out);
+  const Calculator* calculator(const std::string& _type);
+
+  SearchQuery defaults_;
+  const Bisector* bisector_;
+  BisectionCache* bisectionCache_;
+  WorkPool* workPool_;
+  std::unordered_map<std::string, Calculator*> calculators_;
+};
+
+#endif  // SEARCH_QUERYSERVER_H_
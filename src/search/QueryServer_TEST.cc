@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/QueryServer.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "search/BisectionCache.h"
+#include "search/MultilevelBisector.h"
+#include "search/WorkPool.h"
+
+// answers every line of _queries and returns everything written
+static std::string answer(const std::string& _queries) {
+  SearchQuery defaults = {
+    2, 20, 1, U64_MAX, 100, 1000, 0.5, 1, "router_channel_count", 1};
+  MultilevelBisector bisector(12345);
+  BisectionCache cache;
+  WorkPool pool(1);
+  QueryServer server(defaults, &bisector, &cache, &pool);
+
+  FILE* in = fmemopen(const_cast<char*>(_queries.data()), _queries.size(),
+                      "r");
+  char* buffer = nullptr;
+  size_t size = 0;
+  FILE* out = open_memstream(&buffer, &size);
+  server.serve(in, out);
+  fclose(in);
+  fclose(out);
+  std::string written(buffer, size);
+  free(buffer);
+  return written;
+}
+
+TEST(QueryServer, query) {
+  std::string written = answer("{\"id\": \"a\\\"b\", \"maxresults\": 2}\n");
+  EXPECT_EQ(written.find("{\"record\":\"query\",\"id\":\"a\\\"b\"}"), 0u);
+  EXPECT_NE(written.find("\"record\":\"done\",\"id\":\"a\\\"b\""),
+            std::string::npos);
+  EXPECT_EQ(written.find("error"), std::string::npos);
+}
+
+TEST(QueryServer, rejectsBareWords) {
+  // not JSON values, the id must not be echoed
+  for (const char* query : {"{\"id\": abc}", "{\"id\": 1x}", "{\"id\": -}",
+                            "{\"id\": 01}", "{\"id\": nan}",
+                            "{\"id\": True}"}) {
+    EXPECT_EQ(answer(std::string(query) + "\n"),
+              "{\"record\":\"error\",\"message\":"
+              "\"query is not a flat JSON object\"}\n") << query;
+  }
+
+  // JSON numbers and literals are valid ids
+  for (const char* id : {"7", "-0.5e+3", "true", "null"}) {
+    std::string written = answer("{\"id\": " + std::string(id) +
+                                 ", \"minradix\": 1}\n");
+    EXPECT_EQ(written.find("{\"record\":\"error\",\"id\":" +
+                           std::string(id) + ","), 0u) << id;
+  }
+}
+
+TEST(QueryServer, rejectsBadValues) {
+  const char* queries[] = {
+    "{\"id\": 1, \"minbandwidth\": 0}",
+    "{\"id\": 1, \"minbandwidth\": -1}",
+    "{\"id\": 1, \"minbandwidth\": 1e999}",
+    "{\"id\": 1, \"bisectiontrials\": 4294967297}",
+    "{\"id\": 1, \"bisectiontrials\": 0}",
+    "{\"id\": 1, \"minterminals\": 18446744073709551615}"};
+  for (const char* query : queries) {
+    std::string written = answer(std::string(query) + "\n");
+    EXPECT_EQ(written.find("{\"record\":\"error\",\"id\":1,"), 0u) << query;
+    EXPECT_EQ(written.find("\"record\":\"query\""), std::string::npos);
+  }
+}
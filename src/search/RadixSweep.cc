@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/RadixSweep.h"
+
+RadixSweep::RadixSweep(u64 _minRadix, u64 _maxRadix)
+    : minRadix_(_minRadix), maxRadix_(_maxRadix),
+      best_(_maxRadix + 1), found_(_maxRadix + 1, false) {}
+
+RadixSweep::~RadixSweep() {}
+
+void RadixSweep::accepted(const Slimfly& _slimfly) {
+  u64 radix = _slimfly.routerRadix;
+  if (radix > maxRadix_) {
+    return;
+  }
+  if (!found_[radix] || better(_slimfly, best_[radix])) {
+    best_[radix] = _slimfly;
+    found_[radix] = true;
+  }
+}
+
+void RadixSweep::write(FILE* _out) const {
+  fprintf(_out, "radix,terms,routers,channels,terms/router,channels/term\n");
+
+  // the frontier at a radix is the best candidate at or below it
+  bool found = false;
+  Slimfly frontier = Slimfly();
+  for (u64 radix = 0; radix <= maxRadix_; radix++) {
+    if (found_[radix] && (!found || better(best_[radix], frontier))) {
+      frontier = best_[radix];
+      found = true;
+    }
+    if (radix < minRadix_) {
+      continue;
+    }
+    if (!found) {
+      fprintf(_out, "%lu,,,,,\n", radix);
+      continue;
+    }
+    fprintf(_out, "%lu,%lu,%lu,%lu,%.17g,%.17g\n", radix,
+            frontier.terminals, frontier.routers, frontier.channels,
+            static_cast<f64>(frontier.terminals) / frontier.routers,
+            static_cast<f64>(frontier.channels) / frontier.terminals);
+  }
+  fflush(_out);
+}
+
+bool RadixSweep::better(const Slimfly& _lhs, const Slimfly& _rhs) {
+  if (_lhs.terminals != _rhs.terminals) {
+    return _lhs.terminals > _rhs.terminals;
+  }
+  return _lhs.cost < _rhs.cost;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_RADIXSWEEP_H_
+#define SEARCH_RADIXSWEEP_H_
+
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "search/Engine.h"
+
+/*
+ * Collects the accepted candidates of a single engine run and derives, for
+ * every radix in [minRadix, maxRadix], the largest network that fits a router
+ * of at most that radix. Ties on terminals go to the cheaper candidate. This
+ * answers the same question as one binary search over minterminals per radix,
+ * but every bisection is only computed once.
+ */
+class RadixSweep : public ResultListener {
+ public:
+  RadixSweep(u64 _minRadix, u64 _maxRadix);
+  ~RadixSweep();
+  void accepted(const Slimfly& _slimfly) override;
+
+  // writes one CSV row per radix, radices without a solution have no values
+  void write(FILE* _out) const;
+
+ private:
+  u64 minRadix_;
+  u64 maxRadix_;
+  std::vector<Slimfly> best_;  // indexed by exact radix
+  std::vector<bool> found_;
+
+  static bool better(const Slimfly& _lhs, const Slimfly& _rhs);
+};
+
+#endif  // SEARCH_RADIXSWEEP_H_
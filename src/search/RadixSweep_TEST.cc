@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/RadixSweep.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "search/BisectionCache.h"
+#include "search/MultilevelBisector.h"
+#include "search/RouterChannelCount.h"
+#include "search/WorkPool.h"
+
+namespace {
+
+Slimfly makeSlimfly(u64 _radix, u64 _terminals, u64 _routers,
+                    u64 _channels, f64 _cost) {
+  Slimfly slimfly = {2, 5, _routers, _terminals / _routers, _terminals,
+                     _radix, 0.5, _channels, _cost};
+  return slimfly;
+}
+
+std::vector<std::string> lines(const RadixSweep& _sweep) {
+  FILE* out = tmpfile();
+  _sweep.write(out);
+  rewind(out);
+  std::vector<std::string> lines;
+  char buf[256];
+  while (fgets(buf, sizeof(buf), out)) {
+    lines.push_back(std::string(buf));
+    lines.back().pop_back();  // newline
+  }
+  fclose(out);
+  return lines;
+}
+
+}  // namespace
+
+TEST(RadixSweep, frontier) {
+  // the best at each radix carries over to larger radices until beaten,
+  //  equal terminal counts go to the cheaper candidate
+  RadixSweep sweep(3, 8);
+  sweep.accepted(makeSlimfly(4, 100, 25, 100, 5.0));
+  sweep.accepted(makeSlimfly(4, 100, 50, 150, 3.0));  // cheaper, replaces
+  sweep.accepted(makeSlimfly(4, 100, 20, 150, 4.0));  // costlier
+  sweep.accepted(makeSlimfly(4, 90, 45, 150, 1.0));  // fewer terminals
+  sweep.accepted(makeSlimfly(6, 80, 40, 100, 1.0));  // below radix 4's best
+  sweep.accepted(makeSlimfly(7, 200, 100, 500, 9.0));
+  sweep.accepted(makeSlimfly(9, 900, 100, 500, 1.0));  // above the sweep
+  sweep.accepted(makeSlimfly(2, 10, 5, 15, 1.0));  // below, still counts
+
+  std::vector<std::string> expected = {
+    "radix,terms,routers,channels,terms/router,channels/term",
+    "3,10,5,15,2,1.5",
+    "4,100,50,150,2,1.5",
+    "5,100,50,150,2,1.5",
+    "6,100,50,150,2,1.5",
+    "7,200,100,500,2,2.5",
+    "8,200,100,500,2,2.5"};
+  EXPECT_EQ(lines(sweep), expected);
+}
+
+TEST(RadixSweep, empty) {
+  // radices below the first candidate have no values
+  RadixSweep sweep(1, 3);
+  sweep.accepted(makeSlimfly(3, 8, 4, 6, 1.0));
+  std::vector<std::string> expected = {
+    "radix,terms,routers,channels,terms/router,channels/term",
+    "1,,,,,",
+    "2,,,,,",
+    "3,8,4,6,2,0.75"};
+  EXPECT_EQ(lines(sweep), expected);
+  EXPECT_EQ(lines(RadixSweep(2, 2)), std::vector<std::string>({
+      "radix,terms,routers,channels,terms/router,channels/term",
+      "2,,,,,"}));
+}
+
+namespace {
+
+// searches like main() does for a sweep, or for a fixed terminal minimum
+std::deque<Slimfly> search(u64 _maxRadix, u64 _minTerminals,
+                           RadixSweep* _sweep) {
+  RouterChannelCount calc;
+  MultilevelBisector bisector(12345);
+  BisectionCache cache;
+  WorkPool pool(1);
+  Engine engine(2, _maxRadix, 1, U64_MAX, _minTerminals, U64_MAX, 0.5, 10,
+                &calc, &bisector, 1, &cache, &pool);
+  if (_sweep) {
+    engine.addListener(_sweep);
+  }
+  engine.run();
+  return engine.results();
+}
+
+}  // namespace
+
+TEST(RadixSweep, matchesSearches) {
+  // the sweep's terminals at a radix are the largest minterminals for which
+  //  a search with that maximum radix still finds a network
+  RadixSweep sweep(10, 40);
+  search(40, 2, &sweep);
+  std::vector<std::string> rows = lines(sweep);
+  for (u64 radix : {12u, 19u, 27u, 40u}) {
+    const std::string& row = rows.at(radix - 10 + 1);
+    u64 rowRadix, terminals;
+    ASSERT_EQ(sscanf(row.c_str(), "%lu,%lu,", &rowRadix, &terminals), 2)
+        << row;
+    ASSERT_EQ(rowRadix, radix);
+    std::deque<Slimfly> found = search(radix, terminals, nullptr);
+    ASSERT_FALSE(found.empty()) << "radix " << radix;
+    for (const Slimfly& slimfly : found) {
+      EXPECT_EQ(slimfly.terminals, terminals) << "radix " << radix;
+      EXPECT_LE(slimfly.routerRadix, radix);
+    }
+    EXPECT_TRUE(search(radix, terminals + 1, nullptr).empty())
+        << "radix " << radix;
+  }
+}
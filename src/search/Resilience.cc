@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/Resilience.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "search/HopCounts.h"
+
+Resilience::Resilience(const Bisector* _bisector, WorkPool* _workPool,
+                       u64 _trials, u64 _seed)
+    : bisector_(_bisector), workPool_(_workPool), trials_(_trials),
+      seed_(_seed) {}
+
+Resilience::~Resilience() {}
+
+std::vector<f64> Resilience::parseFailures(const std::string& _failures) {
+  std::vector<f64> failures;
+  std::string::size_type start = 0;
+  while (start <= _failures.size()) {
+    std::string::size_type end = _failures.find(',', start);
+    if (end == std::string::npos) {
+      end = _failures.size();
+    }
+    std::string value = _failures.substr(start, end - start);
+    start = end + 1;
+
+    char* rest;
+    f64 percent = strtod(value.c_str(), &rest);
+    if (value.empty() || *rest != '\0' || !(percent >= 0) ||
+        percent > 100) {
+      throw std::runtime_error("resilience must be a comma separated list of "
+                               "percentages from 0 to 100");
+    }
+    failures.push_back(percent / 100);
+  }
+  return failures;
+}
+
+u64 Resilience::split(const SlimflyGraph& _graph,
+                      std::vector<u8>* _where) const {
+  return bisector_->split(_graph.offsets(), _graph.neighbors(), 0, _where);
+}
+
+std::vector<Resilience::Trial> Resilience::run(
+    const SlimflyGraph& _graph, const std::vector<u8>& _where,
+    f64 _failure) const {
+  const std::vector<u32>& offsets = _graph.offsets();
+  const std::vector<u32>& neighbors = _graph.neighbors();
+  u32 numNodes = _graph.numNodes();
+
+  // every channel once, and the cut of the intact partition
+  std::vector<std::pair<u32, u32> > channels;
+  channels.reserve(_graph.numEdges());
+  u64 intactCut = 0;
+  for (u32 u = 0; u < numNodes; u++) {
+    for (u32 e = offsets[u]; e < offsets[u + 1]; e++) {
+      u32 v = neighbors[e];
+      if (u < v) {
+        channels.push_back(std::make_pair(u, v));
+        intactCut += _where[u] != _where[v];
+      }
+    }
+  }
+  u64 numChannels = channels.size();
+  u64 numFailed = std::llround(_failure * numChannels);
+
+  std::vector<Trial> trials(trials_);
+  workPool_->parallelFor(trials_, [&](u64 trial) {
+      std::mt19937_64 random(seed_ ^ (trial * 0x9E3779B97F4A7C15lu));
+
+      /* Pick the failed channels by rejection. When most channels fail,
+       * pick the survivors instead so that the expected number of draws
+       * stays below twice the picks.
+       */
+      bool pickFailed = numFailed <= numChannels / 2;
+      u64 picks = pickFailed ? numFailed : numChannels - numFailed;
+      std::vector<u8> failed(numChannels, pickFailed ? 0 : 1);
+      if (picks > 0) {  // implies channels to draw from
+        std::uniform_int_distribution<u64> anyChannel(0, numChannels - 1);
+        for (u64 picked = 0; picked < picks;) {
+          u64 channel = anyChannel(random);
+          if (failed[channel] == (pickFailed ? 0 : 1)) {
+            failed[channel] = pickFailed ? 1 : 0;
+            picked++;
+          }
+        }
+      }
+
+      // build the damaged graph, the intact cut loses its failed channels
+      std::vector<u32> damagedOffsets(numNodes + 1, 0);
+      u64 cut = intactCut;
+      for (u64 channel = 0; channel < numChannels; channel++) {
+        const std::pair<u32, u32>& ends = channels[channel];
+        if (failed[channel]) {
+          cut -= _where[ends.first] != _where[ends.second];
+        } else {
+          damagedOffsets[ends.first + 1]++;
+          damagedOffsets[ends.second + 1]++;
+        }
+      }
+      for (u32 node = 0; node < numNodes; node++) {
+        damagedOffsets[node + 1] += damagedOffsets[node];
+      }
+      std::vector<u32> damagedNeighbors(damagedOffsets[numNodes]);
+      std::vector<u32> fill(damagedOffsets.begin(), damagedOffsets.end() - 1);
+      for (u64 channel = 0; channel < numChannels; channel++) {
+        if (!failed[channel]) {
+          const std::pair<u32, u32>& ends = channels[channel];
+          damagedNeighbors[fill[ends.first]++] = ends.second;
+          damagedNeighbors[fill[ends.second]++] = ends.first;
+        }
+      }
+
+      // search from a random set of routers
+      std::vector<u32> sources;
+      if (numNodes <= kSources) {
+        for (u32 node = 0; node < numNodes; node++) {
+          sources.push_back(node);
+        }
+      } else {
+        std::vector<u8> chosen(numNodes, 0);
+        std::uniform_int_distribution<u32> anyNode(0, numNodes - 1);
+        while (sources.size() < kSources) {
+          u32 node = anyNode(random);
+          if (!chosen[node]) {
+            chosen[node] = 1;
+            sources.push_back(node);
+          }
+        }
+      }
+      HopCounts hopCounts = sampleHopCounts(damagedOffsets, damagedNeighbors,
+                                            sources);
+
+      // move the intact partition to a nearby better cut of the damaged graph
+      std::vector<u8> where(_where);
+      u64 refined = bisector_->refinePartition(damagedOffsets,
+                                               damagedNeighbors, &where);
+
+      trials[trial].connected = hopCounts.connected;
+      trials[trial].diameter = hopCounts.diameter;
+      trials[trial].averageHops = hopCounts.averageHops;
+      trials[trial].edgeCut = std::min(cut, refined);
+    });
+  return trials;
+}
+
+void Resilience::writeHeader(FILE* _out) {
+  fprintf(_out, "rank,width,concentration,terminals,failure,trials,connected,"
+          "metric,p0,p5,p25,p50,p75,p95,p100\n");
+}
+
+void Resilience::writeRows(FILE* _out, u64 _rank, const Slimfly& _slimfly,
+                           f64 _failure, const std::vector<Trial>& _trials) {
+  u64 connected = 0;
+  std::vector<f64> diameter;
+  std::vector<f64> averageHops;
+  std::vector<f64> bisection;
+  for (const Trial& trial : _trials) {
+    connected += trial.connected;
+    diameter.push_back(trial.diameter);
+    averageHops.push_back(trial.averageHops);
+    bisection.push_back(static_cast<f64>(trial.edgeCut) /
+                        _slimfly.terminals);
+  }
+
+  const char* metrics[] = {"diameter", "avghops", "bisection"};
+  std::vector<f64>* values[] = {&diameter, &averageHops, &bisection};
+  for (u32 metric = 0; metric < 3; metric++) {
+    fprintf(_out, "%lu,%lu,%lu,%lu,%g,%lu,%.6f,%s", _rank, _slimfly.width,
+            _slimfly.concentration, _slimfly.terminals, _failure * 100,
+            _trials.size(), static_cast<f64>(connected) / _trials.size(),
+            metrics[metric]);
+    writePercentiles(_out, *values[metric]);
+  }
+}
+
+void Resilience::writePercentiles(FILE* _out, std::vector<f64> _values) {
+  // nearest rank percentiles
+  std::sort(_values.begin(), _values.end());
+  for (u32 percent : {0, 5, 25, 50, 75, 95, 100}) {
+    u64 rank = std::llround(percent / 100.0 * (_values.size() - 1));
+    fprintf(_out, ",%.6f", _values[rank]);
+  }
+  fprintf(_out, "\n");
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_RESILIENCE_H_
+#define SEARCH_RESILIENCE_H_
+
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "search/Bisector.h"
+#include "search/Engine.h"
+#include "search/SlimflyGraph.h"
+#include "search/WorkPool.h"
+
+/*
+ * Monte Carlo link failure analysis of a Slim Fly router graph. Every trial
+ * removes a uniform random set of the router to router channels and measures
+ * the damaged graph:
+ *  - connectivity and a sampled diameter and average hop count, from a bit
+ *    parallel search out of a random set of routers
+ *  - the bisection, starting from a partition of the intact graph. Its cut
+ *    drops by the failed channels that crossed it, then local refinement
+ *    moves it to a nearby better cut. No trial bisects from scratch.
+ * Only the bisection is incremental. Every trial builds its damaged graph
+ * from the channel list and runs the sampled search on it from scratch.
+ * Trials run concurrently on the work pool. Every trial draws from its own
+ * random stream seeded by the trial number, so the results don't depend on
+ * the number of threads.
+ */
+class Resilience {
+ public:
+  struct Trial {
+    bool connected;
+    u32 diameter;  // sampled, over the reachable pairs
+    f64 averageHops;  // sampled
+    u64 edgeCut;
+  };
+
+  Resilience(const Bisector* _bisector, WorkPool* _workPool, u64 _trials,
+             u64 _seed);
+  ~Resilience();
+
+  // parses a comma separated list of failure percentages
+  static std::vector<f64> parseFailures(const std::string& _failures);
+
+  // a bisection of the intact graph, the start of every trial
+  u64 split(const SlimflyGraph& _graph, std::vector<u8>* _where) const;
+
+  // runs all trials that fail _failure (0 to 1) of the channels
+  std::vector<Trial> run(const SlimflyGraph& _graph,
+                         const std::vector<u8>& _where, f64 _failure) const;
+
+  // CSV output, one row per result, failure rate and metric
+  static void writeHeader(FILE* _out);
+  static void writeRows(FILE* _out, u64 _rank, const Slimfly& _slimfly,
+                        f64 _failure, const std::vector<Trial>& _trials);
+
+ private:
+  const Bisector* bisector_;
+  WorkPool* workPool_;
+  u64 trials_;
+  u64 seed_;
+
+  static const u32 kSources = 128;  // sampled search sources per trial
+
+  static void writePercentiles(FILE* _out, std::vector<f64> _values);
+};
+
+#endif  // SEARCH_RESILIENCE_H_
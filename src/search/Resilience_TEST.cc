@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/Resilience.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "search/MultilevelBisector.h"
+#include "search/SlimflyGraph.h"
+#include "search/WorkPool.h"
+
+TEST(Resilience, parseFailures) {
+  std::vector<f64> failures = Resilience::parseFailures("0,2.5,100");
+  ASSERT_EQ(failures.size(), 3u);
+  EXPECT_EQ(failures[0], 0.0);
+  EXPECT_EQ(failures[1], 0.025);
+  EXPECT_EQ(failures[2], 1.0);
+
+  for (const char* bad : {"", "5,", "-1", "101", "nan", "5%"}) {
+    EXPECT_THROW(Resilience::parseFailures(bad), std::runtime_error) << bad;
+  }
+}
+
+TEST(Resilience, intact) {
+  // without failures every trial sees the intact graph and its split
+  MultilevelBisector bisector(12345);
+  WorkPool pool(2);
+  Resilience analysis(&bisector, &pool, 8, 1);
+  for (u32 width : {5u, 13u}) {
+    SlimflyGraph graph(width, SlimflyGraph::deltaOf(width));
+    std::vector<u8> where;
+    u64 cut = analysis.split(graph, &where);
+    for (const Resilience::Trial& trial : analysis.run(graph, where, 0.0)) {
+      EXPECT_TRUE(trial.connected);
+      EXPECT_EQ(trial.diameter, 2u);
+      EXPECT_GT(trial.averageHops, 1.0);
+      EXPECT_LT(trial.averageHops, 2.0);
+      EXPECT_EQ(trial.edgeCut, cut);
+    }
+  }
+}
+
+TEST(Resilience, allFailed) {
+  MultilevelBisector bisector(12345);
+  WorkPool pool(1);
+  Resilience analysis(&bisector, &pool, 4, 1);
+  SlimflyGraph graph(7, SlimflyGraph::deltaOf(7));
+  std::vector<u8> where;
+  analysis.split(graph, &where);
+  for (const Resilience::Trial& trial : analysis.run(graph, where, 1.0)) {
+    EXPECT_FALSE(trial.connected);
+    EXPECT_EQ(trial.diameter, 0u);
+    EXPECT_EQ(trial.edgeCut, 0u);
+  }
+}
+
+TEST(Resilience, threads) {
+  // every trial has its own random stream, threads don't change the results
+  MultilevelBisector bisector(12345);
+  SlimflyGraph graph(11, SlimflyGraph::deltaOf(11));
+  std::vector<Resilience::Trial> expected;
+  for (u32 threads : {1u, 3u}) {
+    WorkPool pool(threads);
+    Resilience analysis(&bisector, &pool, 16, 7);
+    std::vector<u8> where;
+    u64 cut = analysis.split(graph, &where);
+    std::vector<Resilience::Trial> trials = analysis.run(graph, where, 0.3);
+    ASSERT_EQ(trials.size(), 16u);
+    if (expected.empty()) {
+      expected = trials;
+      continue;
+    }
+    for (u64 idx = 0; idx < trials.size(); idx++) {
+      EXPECT_EQ(trials[idx].connected, expected[idx].connected);
+      EXPECT_EQ(trials[idx].diameter, expected[idx].diameter);
+      EXPECT_EQ(trials[idx].averageHops, expected[idx].averageHops);
+      EXPECT_EQ(trials[idx].edgeCut, expected[idx].edgeCut);
+      EXPECT_LT(trials[idx].edgeCut, cut);
+    }
+  }
+}
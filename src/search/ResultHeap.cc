@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/ResultHeap.h"
+
+#include <algorithm>
+
+ResultHeap::ResultHeap(u64 _capacity)
+    : capacity_(_capacity),
+      nextOrder_(0) {}
+
+ResultHeap::~ResultHeap() {}
+
+void ResultHeap::clear() {
+  heap_.clear();
+  nextOrder_ = 0;
+}
+
+u64 ResultHeap::size() const {
+  return heap_.size();
+}
+
+bool ResultHeap::full() const {
+  return heap_.size() >= capacity_;
+}
+
+const Slimfly& ResultHeap::worst() const {
+  return heap_.front().slimfly;
+}
+
+void ResultHeap::push(const Slimfly& _slimfly) {
+  push(_slimfly, nextOrder_);
+}
+
+void ResultHeap::push(const Slimfly& _slimfly, u64 _order) {
+  nextOrder_ = std::max(nextOrder_, _order + 1);
+  Entry entry = {_order, _slimfly};
+  if (heap_.size() < capacity_) {
+    heap_.push_back(entry);
+    std::push_heap(heap_.begin(), heap_.end(), comparator_);
+  } else if (capacity_ > 0 && comparator_(entry, heap_.front())) {
+    // replace the current worst result
+    std::pop_heap(heap_.begin(), heap_.end(), comparator_);
+    heap_.back() = entry;
+    std::push_heap(heap_.begin(), heap_.end(), comparator_);
+  }
+}
+
+void ResultHeap::merge(const ResultHeap& _other) {
+  for (const Entry& entry : _other.heap_) {
+    push(entry.slimfly, entry.order);
+  }
+}
+
+void ResultHeap::sorted(std::deque<Slimfly>* _sorted) const {
+  std::vector<Entry> entries(heap_);
+  std::sort(entries.begin(), entries.end(), comparator_);
+  _sorted->clear();
+  for (const Entry& entry : entries) {
+    _sorted->push_back(entry.slimfly);
+  }
+}
+
+bool ResultHeap::EntryComparator::operator()(const Entry& _lhs,
+                                             const Entry& _rhs) const {
+  if (comparator_(_lhs.slimfly, _rhs.slimfly)) {
+    return true;
+  } else if (comparator_(_rhs.slimfly, _lhs.slimfly)) {
+    return false;
+  }
+  return _lhs.order < _rhs.order;
+}
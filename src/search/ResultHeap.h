@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_RESULTHEAP_H_
+#define SEARCH_RESULTHEAP_H_
+
+#include <prim/prim.h>
+
+#include <deque>
+#include <vector>
+
+#include "search/Engine.h"
+
+/*
+ * Keeps the best K Slimfly results as ranked by a Comparator. The entries are
+ * held in a max-heap with the worst kept result on top, so an insertion costs
+ * O(log K) and the full sort is only done when the results are read. Results
+ * with equal rank are ordered by insertion order, which can also be given
+ * explicitly so that partial heaps (e.g. from different threads) merge
+ * deterministically.
+ */
+class ResultHeap {
+ public:
+  explicit ResultHeap(u64 _capacity);
+  ~ResultHeap();
+
+  void clear();
+  u64 size() const;
+  bool full() const;
+
+  // the worst result currently kept, only valid when not empty
+  const Slimfly& worst() const;
+
+  void push(const Slimfly& _slimfly);
+  void push(const Slimfly& _slimfly, u64 _order);
+  void merge(const ResultHeap& _other);
+
+  // writes the kept results to _sorted, best first
+  void sorted(std::deque<Slimfly>* _sorted) const;
+
+ private:
+  struct Entry {
+    u64 order;
+    Slimfly slimfly;
+  };
+  class EntryComparator {
+   public:
+    bool operator()(const Entry& _lhs, const Entry& _rhs) const;
+   private:
+    Comparator comparator_;
+  };
+
+  u64 capacity_;
+  u64 nextOrder_;
+  EntryComparator comparator_;
+  std::vector<Entry> heap_;
+};
+
+#endif  // SEARCH_RESULTHEAP_H_
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/ResultHeap.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+// the width tells results of equal cost apart
+static Slimfly makeSlimfly(u64 _width, f64 _cost) {
+  Slimfly slimfly = {2, _width, 0, 0, 0, 0, 0.0, 0, _cost};
+  return slimfly;
+}
+
+TEST(ResultHeap, topK) {
+  ResultHeap heap(5);
+  EXPECT_EQ(heap.size(), 0u);
+  EXPECT_FALSE(heap.full());
+
+  // push a shuffled range of costs, only the 5 cheapest are kept
+  std::vector<u64> costs;
+  for (u64 cost = 0; cost < 100; cost++) {
+    costs.push_back(cost);
+  }
+  std::mt19937_64 random(1);
+  std::shuffle(costs.begin(), costs.end(), random);
+  for (u64 cost : costs) {
+    heap.push(makeSlimfly(cost, cost));
+  }
+  EXPECT_EQ(heap.size(), 5u);
+  EXPECT_TRUE(heap.full());
+  EXPECT_EQ(heap.worst().cost, 4.0);
+
+  std::deque<Slimfly> sorted;
+  heap.sorted(&sorted);
+  ASSERT_EQ(sorted.size(), 5u);
+  for (u64 idx = 0; idx < sorted.size(); idx++) {
+    EXPECT_EQ(sorted[idx].cost, static_cast<f64>(idx));
+  }
+}
+
+TEST(ResultHeap, ties) {
+  // equal costs keep insertion order, earlier results win the last place
+  ResultHeap heap(3);
+  heap.push(makeSlimfly(1, 2.0));
+  heap.push(makeSlimfly(2, 1.0));
+  heap.push(makeSlimfly(3, 2.0));
+  heap.push(makeSlimfly(4, 2.0));
+  heap.push(makeSlimfly(5, 1.0));
+
+  std::deque<Slimfly> sorted;
+  heap.sorted(&sorted);
+  ASSERT_EQ(sorted.size(), 3u);
+  EXPECT_EQ(sorted[0].width, 2u);
+  EXPECT_EQ(sorted[1].width, 5u);
+  EXPECT_EQ(sorted[2].width, 1u);
+}
+
+TEST(ResultHeap, merge) {
+  // explicit orders make the merge independent of how results were split
+  ResultHeap whole(4);
+  ResultHeap even(4);
+  ResultHeap odd(4);
+  for (u64 order = 0; order < 20; order++) {
+    Slimfly slimfly = makeSlimfly(order, (order * 7) % 5);
+    whole.push(slimfly, order);
+    (order % 2 ? odd : even).push(slimfly, order);
+  }
+  even.merge(odd);
+
+  std::deque<Slimfly> expected;
+  std::deque<Slimfly> merged;
+  whole.sorted(&expected);
+  even.sorted(&merged);
+  ASSERT_EQ(merged.size(), expected.size());
+  for (u64 idx = 0; idx < merged.size(); idx++) {
+    EXPECT_EQ(merged[idx].width, expected[idx].width);
+    EXPECT_EQ(merged[idx].cost, expected[idx].cost);
+  }
+  EXPECT_EQ(merged[0].cost, 0.0);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_RESULTWRITER_H_
+#define SEARCH_RESULTWRITER_H_
+
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "search/Calculator.h"
+#include "search/Engine.h"
+
+/*
+ * A ResultWriter formats search output. As an Engine listener it may stream
+ * every accepted candidate while the search runs; finish() is called once
+ * with the final, sorted results. Calculator extension fields are appended
+ * after the regular columns.
+ */
+class ResultWriter : public ResultListener {
+ public:
+  ResultWriter(const Calculator* _calc, FILE* _out);
+  virtual ~ResultWriter();
+  void accepted(const Slimfly& _slimfly) override;
+  bool allCandidates() const override;  // false unless streaming candidates
+  virtual void finish(const std::deque<Slimfly>& _results) = 0;
+
+ protected:
+  // formats a real value so that it reads back exactly
+  static std::string real(f64 _value);
+
+  const Calculator* calc_;
+  FILE* out_;
+  std::vector<std::string> extValues_;  // reused across rows
+};
+
+#endif  // SEARCH_RESULTWRITER_H_
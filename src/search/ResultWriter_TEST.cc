@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/ResultWriter.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "search/ResultWriterFactory.h"
+#include "search/RouterChannelCount.h"
+
+namespace {
+
+// ext fields and values that need CSV quoting and JSON escaping
+class ExtCalculator : public Calculator {
+ public:
+  ExtCalculator()
+      : fields_({"plain", "a,b", "say \"x\""}) {}
+  f64 cost(const Slimfly& _slimfly) const override {
+    return _slimfly.cost;
+  }
+  const std::vector<std::string>& extFields() const override {
+    return fields_;
+  }
+  std::unordered_map<std::string, std::string> extValues(
+      const Slimfly& _slimfly) const override {
+    return {{"plain", std::to_string(_slimfly.width)},
+            {"a,b", "1,2"},
+            {"say \"x\"", "tab\tquote\"back\\slash\nline\x01"}};
+  }
+
+ private:
+  std::vector<std::string> fields_;
+};
+
+const Slimfly kFirst = {2, 5, 50, 3, 150, 10, 0.5, 175, 2.5};
+const Slimfly kSecond = {2, 7, 98, 2, 196, 12, 0.25, 539, 1.5};
+
+// streams both candidates, then finishes with them in rank order
+std::vector<std::string> write(const std::string& _format,
+                               const Calculator* _calc) {
+  FILE* out = tmpfile();
+  ResultWriter* writer = ResultWriterFactory::createResultWriter(
+      _format, _calc, out);
+  EXPECT_TRUE(writer->allCandidates());
+  writer->accepted(kFirst);
+  writer->accepted(kSecond);
+  writer->finish(std::deque<Slimfly>({kSecond, kFirst}));
+  delete writer;
+
+  // lines are split on the newline, values that hold one are quoted
+  rewind(out);
+  std::string text;
+  for (int c = fgetc(out); c != EOF; c = fgetc(out)) {
+    text += static_cast<char>(c);
+  }
+  fclose(out);
+  std::vector<std::string> lines;
+  std::string::size_type start = 0;
+  std::string::size_type end;
+  while ((end = text.find("\n", start)) != std::string::npos) {
+    lines.push_back(text.substr(start, end - start));
+    start = end + 1;
+  }
+  EXPECT_EQ(start, text.size());
+  return lines;
+}
+
+}  // namespace
+
+TEST(ResultWriter, csv) {
+  RouterChannelCount plain;
+  std::vector<std::string> lines = write("csv", &plain);
+  ASSERT_EQ(lines.size(), 5u);
+  EXPECT_EQ(lines[0], "record,rank,dimensions,width,concentration,terminals,"
+            "routers,radix,channels,bisection,cost");
+  EXPECT_EQ(lines[1], "candidate,,2,5,3,150,50,10,175,0.5,2.5");
+  EXPECT_EQ(lines[2], "candidate,,2,7,2,196,98,12,539,0.25,1.5");
+  EXPECT_EQ(lines[3], "result,1,2,7,2,196,98,12,539,0.25,1.5");
+  EXPECT_EQ(lines[4], "result,2,2,5,3,150,50,10,175,0.5,2.5");
+}
+
+TEST(ResultWriter, csvExt) {
+  // fields with commas, quotes or newlines are quoted, quotes doubled
+  ExtCalculator calc;
+  std::vector<std::string> lines = write("csv", &calc);
+  ASSERT_EQ(lines.size(), 9u);
+  EXPECT_EQ(lines[0], "record,rank,dimensions,width,concentration,terminals,"
+            "routers,radix,channels,bisection,cost,plain,\"a,b\","
+            "\"say \"\"x\"\"\"");
+  EXPECT_EQ(lines[1], "candidate,,2,5,3,150,50,10,175,0.5,2.5,5,\"1,2\","
+            "\"tab\tquote\"\"back\\slash");
+  EXPECT_EQ(lines[2], "line\x01\"");
+  EXPECT_EQ(lines[5], "result,1,2,7,2,196,98,12,539,0.25,1.5,7,\"1,2\","
+            "\"tab\tquote\"\"back\\slash");
+  EXPECT_EQ(lines[7], "result,2,2,5,3,150,50,10,175,0.5,2.5,5,\"1,2\","
+            "\"tab\tquote\"\"back\\slash");
+}
+
+TEST(ResultWriter, jsonl) {
+  RouterChannelCount plain;
+  std::vector<std::string> lines = write("jsonl", &plain);
+  ASSERT_EQ(lines.size(), 4u);
+  EXPECT_EQ(lines[0], "{\"record\":\"candidate\",\"dimensions\":2,"
+            "\"width\":5,\"concentration\":3,\"terminals\":150,"
+            "\"routers\":50,\"radix\":10,\"channels\":175,"
+            "\"bisection\":0.5,\"cost\":2.5}");
+  EXPECT_EQ(lines[2], "{\"record\":\"result\",\"rank\":1,\"dimensions\":2,"
+            "\"width\":7,\"concentration\":2,\"terminals\":196,"
+            "\"routers\":98,\"radix\":12,\"channels\":539,"
+            "\"bisection\":0.25,\"cost\":1.5}");
+  EXPECT_EQ(lines[3], "{\"record\":\"result\",\"rank\":2,\"dimensions\":2,"
+            "\"width\":5,\"concentration\":3,\"terminals\":150,"
+            "\"routers\":50,\"radix\":10,\"channels\":175,"
+            "\"bisection\":0.5,\"cost\":2.5}");
+}
+
+TEST(ResultWriter, jsonlExt) {
+  // quotes and backslashes are escaped, control characters become \u00XX
+  ExtCalculator calc;
+  std::vector<std::string> lines = write("jsonl", &calc);
+  ASSERT_EQ(lines.size(), 4u);
+  const std::string ext = ",\"ext\":{\"plain\":\"5\",\"a,b\":\"1,2\","
+      "\"say \\\"x\\\"\":\"tab\\u0009quote\\\"back\\\\slash\\u000aline"
+      "\\u0001\"}}";
+  EXPECT_EQ(lines[0], "{\"record\":\"candidate\",\"dimensions\":2,"
+            "\"width\":5,\"concentration\":3,\"terminals\":150,"
+            "\"routers\":50,\"radix\":10,\"channels\":175,"
+            "\"bisection\":0.5,\"cost\":2.5" + ext);
+  EXPECT_EQ(lines[3], "{\"record\":\"result\",\"rank\":2,\"dimensions\":2,"
+            "\"width\":5,\"concentration\":3,\"terminals\":150,"
+            "\"routers\":50,\"radix\":10,\"channels\":175,"
+            "\"bisection\":0.5,\"cost\":2.5" + ext);
+}
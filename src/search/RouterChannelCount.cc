@@ -34,7 +34,3 @@
 RouterChannelCount::RouterChannelCount() {}
 
 RouterChannelCount::~RouterChannelCount() {}
-
-f64 RouterChannelCount::cost(const Slimfly& _slimfly) const {
-  return _slimfly.routers + _slimfly.channels * 0.000000001;
-}
@@ -34,14 +34,31 @@
 
 #include <prim/prim.h>
 
-#include "search/Calculator.h"
 #include "search/Engine.h"
+#include "search/StaticCalculator.h"
 
-class RouterChannelCount : public Calculator {
+class RouterChannelCount : public StaticCalculator<RouterChannelCount> {
  public:
   RouterChannelCount();
   ~RouterChannelCount();
-  f64 cost(const Slimfly& _slimfly) const override;
+
+  static f64 costOf(u64 _width, u64 _concentration, u64 _terminals,
+                    u64 _routers, u64 _routerRadix, u64 _channels,
+                    f64 _bisections) {
+    (void)_bisections;  // unused
+    return costBoundOf(_width, _concentration, _terminals, _routers,
+                       _routerRadix, _channels);
+  }
+
+  // the cost doesn't depend on the bisection, the bound is exact
+  static f64 costBoundOf(u64 _width, u64 _concentration, u64 _terminals,
+                         u64 _routers, u64 _routerRadix, u64 _channels) {
+    (void)_width;  // unused
+    (void)_concentration;  // unused
+    (void)_terminals;  // unused
+    (void)_routerRadix;  // unused
+    return _routers + _channels * 0.000000001;
+  }
 };
 
 #endif  // SEARCH_ROUTERCHANNELCOUNT_H_
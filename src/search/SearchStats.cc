@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SearchStats.h"
+
+#include <sys/resource.h>
+
+#include <cstdio>
+
+void SearchStats::clear() {
+  *this = SearchStats();
+}
+
+u64 SearchStats::peakRss() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  return usage.ru_maxrss;  // already kibibytes on Linux
+}
+
+static f64 seconds(u64 _nanoseconds) {
+  return _nanoseconds / 1e9;
+}
+
+std::string SearchStats::text() const {
+  char buf[2048];
+  snprintf(buf, sizeof(buf),
+           "search statistics:\n"
+           "  stage1 widths          %12lu  rejected: terminals %lu, "
+           "radix %lu\n"
+           "  stage2 concentrations  %12lu  rejected: terminals %lu, "
+           "radix %lu\n"
+           "  stage3 bandwidth tests %12lu  rejected: radix %lu, "
+           "bandwidth %lu\n"
+           "         decided by bounds %9lu  (%lu accepted, %lu rejected)\n"
+           "         partitions run  %11lu  (%lu trials, %lu skipped, "
+           "%lu cut short)\n"
+           "         pruned by cost bound %8lu\n"
+           "  stage5 costed          %12lu\n"
+           "  time: enumerate %.6fs, filter %.6fs, bounds %.6fs, "
+           "graph build %.6fs, partition %.6fs, cost %.6fs, total %.6fs\n"
+           "  peak RSS: %lu KiB\n",
+           widths, widthsRejectedTerminals, widthsRejectedRadix,
+           concentrations, concentrationsRejectedTerminals,
+           concentrationsRejectedRadix,
+           bandwidthTests, bandwidthRejectedRadix, bandwidthRejectedBandwidth,
+           boundsAccepted + boundsRejected, boundsAccepted, boundsRejected,
+           partitions, trials, trialsSkipped, trialsCutShort, pruned, costed,
+           seconds(enumerateTime), seconds(filterTime),
+           seconds(boundsTime), seconds(graphBuildTime),
+           seconds(partitionTime), seconds(costTime), seconds(totalTime),
+           peakRss());
+  return buf;
+}
+
+std::string SearchStats::json() const {
+  char buf[2048];
+  snprintf(buf, sizeof(buf),
+           "{\"stage1\":{\"widths\":%lu,\"rejected\":{\"terminals\":%lu,"
+           "\"radix\":%lu}},"
+           "\"stage2\":{\"concentrations\":%lu,\"rejected\":{\"terminals\":%lu,"
+           "\"radix\":%lu}},"
+           "\"stage3\":{\"tests\":%lu,\"rejected\":{\"radix\":%lu,"
+           "\"bandwidth\":%lu},\"bounds\":{\"accepted\":%lu,\"rejected\":%lu},"
+           "\"partitions\":%lu,\"trials\":%lu,\"trials_skipped\":%lu,"
+           "\"trials_cut_short\":%lu,\"pruned\":%lu},"
+           "\"stage5\":{\"costed\":%lu},"
+           "\"seconds\":{\"enumerate\":%.9f,\"filter\":%.9f,"
+           "\"bounds\":%.9f,\"graph_build\":%.9f,"
+           "\"partition\":%.9f,\"cost\":%.9f,\"total\":%.9f},"
+           "\"peak_rss_kib\":%lu}",
+           widths, widthsRejectedTerminals, widthsRejectedRadix,
+           concentrations, concentrationsRejectedTerminals,
+           concentrationsRejectedRadix,
+           bandwidthTests, bandwidthRejectedRadix, bandwidthRejectedBandwidth,
+           boundsAccepted, boundsRejected, partitions, trials, trialsSkipped,
+           trialsCutShort, pruned, costed,
+           seconds(enumerateTime), seconds(filterTime),
+           seconds(boundsTime), seconds(graphBuildTime),
+           seconds(partitionTime), seconds(costTime), seconds(totalTime),
+           peakRss());
+  return buf;
+}
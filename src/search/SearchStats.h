@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_SEARCHSTATS_H_
+#define SEARCH_SEARCHSTATS_H_
+
+#include <prim/prim.h>
+
+#include <chrono>
+#include <string>
+
+/*
+ * Counters and timers collected by every Engine run. Each stage counts the
+ * items it was given and why it rejected some of them. Times are wall clock
+ * nanoseconds; graph build and partition times are summed over all threads.
+ */
+struct SearchStats {
+  // stage 1: widths (prime powers)
+  u64 widths = 0;
+  u64 widthsRejectedTerminals = 0;
+  u64 widthsRejectedRadix = 0;
+  // stage 2: (width, concentration) pairs
+  u64 concentrations = 0;
+  u64 concentrationsRejectedTerminals = 0;
+  u64 concentrationsRejectedRadix = 0;
+  // stage 3: bandwidth test
+  u64 bandwidthTests = 0;
+  u64 bandwidthRejectedRadix = 0;
+  u64 bandwidthRejectedBandwidth = 0;
+  u64 boundsAccepted = 0;
+  u64 boundsRejected = 0;
+  u64 partitions = 0;
+  u64 trials = 0;
+  u64 trialsSkipped = 0;
+  u64 trialsCutShort = 0;  // decided below the threshold before the end
+  u64 pruned = 0;  // skipped, their cost bound can't beat the results
+  // stage 4 and 5: channel count and cost
+  u64 costed = 0;
+
+  u64 enumerateTime = 0;
+  u64 filterTime = 0;
+  u64 boundsTime = 0;
+  u64 graphBuildTime = 0;
+  u64 partitionTime = 0;
+  u64 costTime = 0;
+  u64 totalTime = 0;
+
+  void clear();
+
+  // peak resident set size of the whole process in kibibytes
+  static u64 peakRss();
+
+  // human readable and single line JSON summaries
+  std::string text() const;
+  std::string json() const;
+};
+
+// nanoseconds since an arbitrary fixed point
+inline u64 statsClock() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif  // SEARCH_SEARCHSTATS_H_
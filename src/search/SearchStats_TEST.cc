@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SearchStats.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "search/BisectionCache.h"
+#include "search/Engine.h"
+#include "search/MultilevelBisector.h"
+#include "search/RouterChannelCount.h"
+#include "search/WorkPool.h"
+
+namespace {
+
+// counts the accepted candidates, all of them or only the promising ones
+class Counter : public ResultListener {
+ public:
+  explicit Counter(bool _all) : all_(_all), accepted_(0) {}
+  void accepted(const Slimfly& _slimfly) override {
+    (void)_slimfly;  // unused
+    accepted_++;
+  }
+  bool allCandidates() const override {
+    return all_;
+  }
+  u64 count() const {
+    return accepted_;
+  }
+
+ private:
+  bool all_;
+  u64 accepted_;
+};
+
+SearchStats search(bool _all, u64 _trials, u64* _accepted) {
+  RouterChannelCount calc;
+  MultilevelBisector bisector(12345);
+  BisectionCache cache;
+  WorkPool pool(2);
+  Engine engine(4, 120, 2, 40, 500, 200000, 0.6, 5, &calc, &bisector,
+                _trials, &cache, &pool);
+  Counter counter(_all);
+  engine.addListener(&counter);
+  engine.run();
+  *_accepted = counter.count();
+  return engine.stats();
+}
+
+/*
+ * Parses a JSON object of nested objects and numbers into dotted key paths,
+ * e.g. {"a":{"b":1}} gives "a.b" = 1. Returns false on anything else.
+ */
+class JsonParser {
+ public:
+  explicit JsonParser(const std::string& _text) : text_(_text), pos_(0) {}
+
+  bool parse(std::map<std::string, f64>* _values) {
+    values_ = _values;
+    return object("") && pos_ == text_.size();
+  }
+
+ private:
+  bool object(const std::string& _prefix) {
+    if (!consume('{')) {
+      return false;
+    }
+    if (consume('}')) {
+      return true;
+    }
+    do {
+      std::string key;
+      if (!string(&key) || !consume(':')) {
+        return false;
+      }
+      std::string path = _prefix.empty() ? key : _prefix + "." + key;
+      if (pos_ < text_.size() && text_[pos_] == '{') {
+        if (!object(path)) {
+          return false;
+        }
+      } else if (!number(path)) {
+        return false;
+      }
+    } while (consume(','));
+    return consume('}');
+  }
+
+  bool string(std::string* _value) {
+    if (!consume('"')) {
+      return false;
+    }
+    std::string::size_type end = text_.find('"', pos_);
+    if (end == std::string::npos) {
+      return false;
+    }
+    *_value = text_.substr(pos_, end - pos_);
+    pos_ = end + 1;
+    return true;
+  }
+
+  bool number(const std::string& _path) {
+    const char* begin = text_.c_str() + pos_;
+    char* end;
+    f64 value = strtod(begin, &end);
+    if (end == begin || !isdigit(static_cast<u8>(*begin))) {
+      return false;
+    }
+    pos_ += end - begin;
+    return values_->insert(std::make_pair(_path, value)).second;
+  }
+
+  bool consume(char _c) {
+    if (pos_ < text_.size() && text_[pos_] == _c) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  const std::string& text_;
+  std::string::size_type pos_;
+  std::map<std::string, f64>* values_;
+};
+
+}  // namespace
+
+TEST(SearchStats, stagesAddUp) {
+  for (bool all : {true, false}) {
+    for (u64 trials : {1u, 3u}) {
+      u64 accepted;
+      SearchStats stats = search(all, trials, &accepted);
+      EXPECT_GT(stats.widths, 0u);
+      EXPECT_LE(stats.widthsRejectedTerminals + stats.widthsRejectedRadix,
+                stats.widths);
+
+      // every stage accounts for all items the previous one passed on
+      EXPECT_EQ(stats.concentrations,
+                stats.concentrationsRejectedTerminals +
+                stats.concentrationsRejectedRadix + stats.bandwidthTests);
+      EXPECT_EQ(stats.bandwidthTests,
+                stats.bandwidthRejectedRadix +
+                stats.bandwidthRejectedBandwidth + stats.costed +
+                stats.pruned);
+      EXPECT_LE(stats.boundsAccepted + stats.boundsRejected,
+                stats.bandwidthTests - stats.bandwidthRejectedRadix);
+      EXPECT_EQ(stats.trials + stats.trialsSkipped,
+                stats.partitions * trials);
+      EXPECT_LE(stats.partitions, stats.trials);
+      EXPECT_EQ(stats.costed, accepted);
+      EXPECT_GT(stats.costed, 0u);
+      if (all) {
+        EXPECT_EQ(stats.pruned, 0u);
+      }
+      EXPECT_GE(stats.totalTime, stats.enumerateTime + stats.filterTime);
+    }
+  }
+}
+
+TEST(SearchStats, json) {
+  u64 accepted;
+  SearchStats stats = search(true, 1, &accepted);
+  std::map<std::string, f64> values;
+  ASSERT_TRUE(JsonParser(stats.json()).parse(&values)) << stats.json();
+
+  const std::map<std::string, u64> counters = {
+    {"stage1.widths", stats.widths},
+    {"stage1.rejected.terminals", stats.widthsRejectedTerminals},
+    {"stage1.rejected.radix", stats.widthsRejectedRadix},
+    {"stage2.concentrations", stats.concentrations},
+    {"stage2.rejected.terminals", stats.concentrationsRejectedTerminals},
+    {"stage2.rejected.radix", stats.concentrationsRejectedRadix},
+    {"stage3.tests", stats.bandwidthTests},
+    {"stage3.rejected.radix", stats.bandwidthRejectedRadix},
+    {"stage3.rejected.bandwidth", stats.bandwidthRejectedBandwidth},
+    {"stage3.bounds.accepted", stats.boundsAccepted},
+    {"stage3.bounds.rejected", stats.boundsRejected},
+    {"stage3.partitions", stats.partitions},
+    {"stage3.trials", stats.trials},
+    {"stage3.trials_skipped", stats.trialsSkipped},
+    {"stage3.trials_cut_short", stats.trialsCutShort},
+    {"stage3.pruned", stats.pruned},
+    {"stage5.costed", stats.costed}};
+  for (const auto& counter : counters) {
+    ASSERT_EQ(values.count(counter.first), 1u) << counter.first;
+    EXPECT_EQ(values[counter.first], counter.second) << counter.first;
+  }
+  for (const char* time : {"enumerate", "filter", "bounds", "graph_build",
+                           "partition", "cost", "total"}) {
+    EXPECT_EQ(values.count(std::string("seconds.") + time), 1u) << time;
+  }
+  EXPECT_NEAR(values["seconds.total"], stats.totalTime / 1e9, 1e-8);
+  EXPECT_EQ(values.count("peak_rss_kib"), 1u);
+  EXPECT_EQ(values.size(), counters.size() + 8);
+
+  // the text form names every stage
+  std::string text = stats.text();
+  for (const char* stage : {"stage1", "stage2", "stage3", "stage5",
+                            "peak RSS"}) {
+    EXPECT_NE(text.find(stage), std::string::npos) << stage;
+  }
+}
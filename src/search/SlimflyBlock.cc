@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SlimflyBlock.h"
+
+u64 SlimflyBlock::size() const {
+  return width.size();
+}
+
+void SlimflyBlock::clear() {
+  dimensions.clear();
+  width.clear();
+  routers.clear();
+  concentration.clear();
+  terminals.clear();
+  routerRadix.clear();
+  bisections.clear();
+  channels.clear();
+  cost.clear();
+}
+
+void SlimflyBlock::reserve(u64 _capacity) {
+  dimensions.reserve(_capacity);
+  width.reserve(_capacity);
+  routers.reserve(_capacity);
+  concentration.reserve(_capacity);
+  terminals.reserve(_capacity);
+  routerRadix.reserve(_capacity);
+  bisections.reserve(_capacity);
+  channels.reserve(_capacity);
+  cost.reserve(_capacity);
+}
+
+void SlimflyBlock::push(const Slimfly& _slimfly) {
+  dimensions.push_back(_slimfly.dimensions);
+  width.push_back(_slimfly.width);
+  routers.push_back(_slimfly.routers);
+  concentration.push_back(_slimfly.concentration);
+  terminals.push_back(_slimfly.terminals);
+  routerRadix.push_back(_slimfly.routerRadix);
+  bisections.push_back(_slimfly.bisections);
+  channels.push_back(_slimfly.channels);
+  cost.push_back(_slimfly.cost);
+}
+
+Slimfly SlimflyBlock::get(u64 _idx) const {
+  Slimfly slimfly;
+  slimfly.dimensions = dimensions[_idx];
+  slimfly.width = width[_idx];
+  slimfly.routers = routers[_idx];
+  slimfly.concentration = concentration[_idx];
+  slimfly.terminals = terminals[_idx];
+  slimfly.routerRadix = routerRadix[_idx];
+  slimfly.bisections = bisections[_idx];
+  slimfly.channels = channels[_idx];
+  slimfly.cost = cost[_idx];
+  return slimfly;
+}
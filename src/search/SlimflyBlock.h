@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_SLIMFLYBLOCK_H_
+#define SEARCH_SLIMFLYBLOCK_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+#include "search/Engine.h"
+
+/*
+ * A block of Slimfly candidates stored as a structure of arrays, one column
+ * per Slimfly field, so that batch passes like cost evaluation run over
+ * contiguous memory.
+ */
+struct SlimflyBlock {
+  std::vector<u64> dimensions;
+  std::vector<u64> width;
+  std::vector<u64> routers;
+  std::vector<u64> concentration;
+  std::vector<u64> terminals;
+  std::vector<u64> routerRadix;
+  std::vector<f64> bisections;
+  std::vector<u64> channels;
+  std::vector<f64> cost;
+
+  u64 size() const;
+  void clear();
+  void reserve(u64 _capacity);
+  void push(const Slimfly& _slimfly);
+  Slimfly get(u64 _idx) const;
+};
+
+#endif  // SEARCH_SLIMFLYBLOCK_H_
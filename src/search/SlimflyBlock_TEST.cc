@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SlimflyBlock.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+TEST(SlimflyBlock, pushGet) {
+  // every field of every row gets its own value
+  SlimflyBlock block;
+  block.reserve(10);
+  EXPECT_EQ(block.size(), 0u);
+  for (u64 row = 0; row < 10; row++) {
+    Slimfly slimfly = {row * 9 + 1, row * 9 + 2, row * 9 + 3, row * 9 + 4,
+                       row * 9 + 5, row * 9 + 6, row * 9 + 7.25,
+                       row * 9 + 8, row * 9 + 9.5};
+    block.push(slimfly);
+  }
+  ASSERT_EQ(block.size(), 10u);
+  for (u64 row = 0; row < 10; row++) {
+    Slimfly slimfly = block.get(row);
+    EXPECT_EQ(slimfly.dimensions, row * 9 + 1);
+    EXPECT_EQ(slimfly.width, row * 9 + 2);
+    EXPECT_EQ(slimfly.routers, row * 9 + 3);
+    EXPECT_EQ(slimfly.concentration, row * 9 + 4);
+    EXPECT_EQ(slimfly.terminals, row * 9 + 5);
+    EXPECT_EQ(slimfly.routerRadix, row * 9 + 6);
+    EXPECT_EQ(slimfly.bisections, row * 9 + 7.25);
+    EXPECT_EQ(slimfly.channels, row * 9 + 8);
+    EXPECT_EQ(slimfly.cost, row * 9 + 9.5);
+  }
+
+  // the columns hold the same values
+  EXPECT_EQ(block.terminals[3], 32u);
+  EXPECT_EQ(block.cost[3], 36.5);
+
+  block.clear();
+  EXPECT_EQ(block.size(), 0u);
+  EXPECT_TRUE(block.dimensions.empty());
+  EXPECT_TRUE(block.bisections.empty());
+  EXPECT_TRUE(block.cost.empty());
+}
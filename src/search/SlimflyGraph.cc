@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SlimflyGraph.h"
+
+#include "search/GaloisField.h"
+#include "search/util.h"
+
+static const u32 NUM_GRAPHS = 2;
+
+SlimflyGraph::SlimflyGraph(u32 _width, s32 _delta)
+    : width_(_width), delta_(_delta) {
+  const GaloisField& field = *GaloisField::get(width_);
+  std::vector<u32> X, X_i;
+  createGeneratorSet(field, delta_, X, X_i);
+
+  // mark the row differences that are linked within each subgraph
+  std::vector<u8> distMask[NUM_GRAPHS];
+  for (u32 graph = 0; graph < NUM_GRAPHS; graph++) {
+    const std::vector<u32>& dVtr = (graph == 0) ? X : X_i;
+    distMask[graph].assign(width_, 0);
+    for (u32 dist : dVtr) {
+      distMask[graph][dist] = 1;
+    }
+  }
+
+  // every router has its intra subgraph links plus exactly one link to each
+  //  column of the other subgraph, so the offsets are known up front
+  u32 numNodes = NUM_GRAPHS * width_ * width_;
+  offsets_.resize(numNodes + 1);
+  offsets_[0] = 0;
+  for (u32 graph = 0; graph < NUM_GRAPHS; graph++) {
+    u32 intra = 0;
+    for (u32 dist = 0; dist < width_; dist++) {
+      intra += distMask[graph][dist];
+    }
+    for (u32 idx = 0; idx < width_ * width_; idx++) {
+      offsets_[graph * width_ * width_ + idx + 1] = intra + width_;
+    }
+  }
+  for (u32 id = 0; id < numNodes; id++) {
+    offsets_[id + 1] += offsets_[id];
+  }
+  neighbors_.resize(offsets_[numNodes]);
+
+  for (u32 graph = 0; graph < NUM_GRAPHS; graph++) {
+    const std::vector<u8>& mask = distMask[graph];
+    for (u32 col = 0; col < width_; col++) {
+      for (u32 srcRow = 0; srcRow < width_; srcRow++) {
+        u32 src = routerId(graph, col, srcRow, width_);
+        u32* out = &neighbors_[offsets_[src]];
+
+        // link routers via channels: Intra subgraph connections where
+        //  rows are linked when their difference is in the generator set
+        for (u32 dstRow = 0; dstRow < width_; dstRow++) {
+          if (mask[field.sub(dstRow, srcRow)]) {
+            *out++ = routerId(graph, col, dstRow, width_);
+          }
+        }
+
+        // link routers via channels: Inter subgraph connections where
+        //  (0, x, y) links to (1, m, c) when y = m*x + c
+        for (u32 other = 0; other < width_; other++) {
+          u32 prod = field.mul(other, col);
+          if (graph == 0) {
+            u32 c = field.sub(srcRow, prod);
+            *out++ = routerId(1, other, c, width_);
+          } else {
+            u32 y = field.add(prod, srcRow);
+            *out++ = routerId(0, other, y, width_);
+          }
+        }
+      }
+    }
+  }
+}
+
+SlimflyGraph::~SlimflyGraph() {}
+
+u32 SlimflyGraph::width() const {
+  return width_;
+}
+
+s32 SlimflyGraph::delta() const {
+  return delta_;
+}
+
+u32 SlimflyGraph::numNodes() const {
+  return offsets_.size() - 1;
+}
+
+u64 SlimflyGraph::numEdges() const {
+  return neighbors_.size() / 2;
+}
+
+u32 SlimflyGraph::degree(u32 _node) const {
+  return offsets_[_node + 1] - offsets_[_node];
+}
+
+const std::vector<u32>& SlimflyGraph::offsets() const {
+  return offsets_;
+}
+
+const std::vector<u32>& SlimflyGraph::neighbors() const {
+  return neighbors_;
+}
+
+u32 SlimflyGraph::routerId(u32 _graph, u32 _col, u32 _row, u32 _width) {
+  return _row + (_width * _col) + (_width * _width * _graph);
+}
+
+s32 SlimflyGraph::deltaOf(u32 _width) {
+  // width - 4*round(width/4), rounding halves up (only even widths hit them)
+  return static_cast<s32>(_width) - 4 * static_cast<s32>((_width + 2) / 4);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_SLIMFLYGRAPH_H_
+#define SEARCH_SLIMFLYGRAPH_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+/*
+ * The router graph of a Slim Fly with the given width (S) and delta, stored
+ * in compressed sparse row form. The width may be any prime power, all
+ * arithmetic is done in GF(S). Router (graph, col, row) has the id
+ * graph*S*S + col*S + row. Neighbor lists are 0-based, every channel appears
+ * in both directions, and the layout matches the METIS xadj/adjncy arrays so
+ * the graph can be handed to any Bisector as is.
+ */
+class SlimflyGraph {
+ public:
+  SlimflyGraph(u32 _width, s32 _delta);
+  ~SlimflyGraph();
+
+  u32 width() const;
+  s32 delta() const;
+  u32 numNodes() const;
+  u64 numEdges() const;  // undirected
+  u32 degree(u32 _node) const;
+
+  const std::vector<u32>& offsets() const;
+  const std::vector<u32>& neighbors() const;
+
+  static u32 routerId(u32 _graph, u32 _col, u32 _row, u32 _width);
+  // delta for a width: S = 4w + delta with delta in {-1, 0, 1}
+  static s32 deltaOf(u32 _width);
+
+ private:
+  u32 width_;
+  s32 delta_;
+  std::vector<u32> offsets_;
+  std::vector<u32> neighbors_;
+};
+
+#endif  // SEARCH_SLIMFLYGRAPH_H_
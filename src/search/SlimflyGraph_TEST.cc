@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SlimflyGraph.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "search/util.h"
+
+// the longest shortest path from _source
+static u32 eccentricity(const SlimflyGraph& _graph, u32 _source) {
+  std::vector<u32> distance(_graph.numNodes(), U32_MAX);
+  std::vector<u32> queue(1, _source);
+  distance[_source] = 0;
+  u32 farthest = 0;
+  for (u64 head = 0; head < queue.size(); head++) {
+    u32 node = queue[head];
+    farthest = std::max(farthest, distance[node]);
+    for (u32 e = _graph.offsets()[node]; e < _graph.offsets()[node + 1];
+         e++) {
+      u32 next = _graph.neighbors()[e];
+      if (distance[next] == U32_MAX) {
+        distance[next] = distance[node] + 1;
+        queue.push_back(next);
+      }
+    }
+  }
+  return (queue.size() == _graph.numNodes()) ? farthest : U32_MAX;
+}
+
+TEST(SlimflyGraph, deltaOf) {
+  // q = 4w + delta with delta in {-1, 0, 1}
+  const s32 expected[][2] = {
+    {4, 0}, {5, 1}, {7, -1}, {8, 0}, {9, 1}, {11, -1}, {13, 1}, {16, 0},
+    {17, 1}, {19, -1}, {23, -1}, {25, 1}, {27, -1}, {29, 1}, {32, 0}};
+  for (const auto& width : expected) {
+    EXPECT_EQ(SlimflyGraph::deltaOf(width[0]), width[1])
+        << "width " << width[0];
+  }
+  for (u32 q : primePowers(4, 1000)) {
+    s32 delta = SlimflyGraph::deltaOf(q);
+    EXPECT_TRUE(delta >= -1 && delta <= 1) << "width " << q;
+    EXPECT_EQ((static_cast<s32>(q) - delta) % 4, 0) << "width " << q;
+  }
+}
+
+TEST(SlimflyGraph, structure) {
+  for (u32 q : primePowers(5, 49)) {
+    s32 delta = SlimflyGraph::deltaOf(q);
+    SlimflyGraph graph(q, delta);
+    ASSERT_EQ(graph.numNodes(), 2 * q * q);
+
+    // every router has (3q - delta) / 2 channels, no self loops or
+    //  duplicates, and every channel appears in both directions
+    u32 degree = (3 * q - delta) / 2;
+    for (u32 node = 0; node < graph.numNodes(); node++) {
+      ASSERT_EQ(graph.degree(node), degree) << "width " << q;
+      std::vector<u32> adjacent(
+          graph.neighbors().begin() + graph.offsets()[node],
+          graph.neighbors().begin() + graph.offsets()[node + 1]);
+      std::sort(adjacent.begin(), adjacent.end());
+      EXPECT_TRUE(std::adjacent_find(adjacent.begin(), adjacent.end()) ==
+                  adjacent.end());
+      for (u32 other : adjacent) {
+        ASSERT_NE(other, node);
+        const u32* begin = &graph.neighbors()[graph.offsets()[other]];
+        const u32* end = begin + graph.degree(other);
+        ASSERT_TRUE(std::find(begin, end, node) != end);
+      }
+    }
+    EXPECT_EQ(graph.numEdges(), static_cast<u64>(graph.numNodes()) *
+              degree / 2);
+  }
+}
+
+TEST(SlimflyGraph, diameter) {
+  // the MMS graphs have diameter 2, check a router of every column
+  for (u32 q : primePowers(5, 49)) {
+    SlimflyGraph graph(q, SlimflyGraph::deltaOf(q));
+    for (u32 sub = 0; sub < 2; sub++) {
+      for (u32 col = 0; col < q; col++) {
+        u32 source = SlimflyGraph::routerId(sub, col, col % q, q);
+        ASSERT_EQ(eccentricity(graph, source), 2u)
+            << "width " << q << " router " << source;
+      }
+    }
+  }
+}
+
+TEST(SlimflyGraph, definition) {
+  /* For every prime width up to 101, the neighbors are exactly those of the
+   * MMS definition in plain modular arithmetic: (g, x, y) links to (g, x, y')
+   * when y' - y is in X (g = 0) or X' (g = 1), and (0, x, y) links to
+   * (1, m, c) when y = m*x + c.
+   */
+  for (u32 q : sievePrimes(101)) {
+    if (q < 5) {
+      continue;
+    }
+    s32 delta = SlimflyGraph::deltaOf(q);
+    SlimflyGraph graph(q, delta);
+    std::vector<u32> X, X_i;
+    createGeneratorSet(q, delta, X, X_i);
+    std::vector<u8> linked[2];
+    linked[0].assign(q, 0);
+    linked[1].assign(q, 0);
+    for (u32 dist : X) {
+      linked[0][dist] = 1;
+    }
+    for (u32 dist : X_i) {
+      linked[1][dist] = 1;
+    }
+
+    for (u32 sub = 0; sub < 2; sub++) {
+      for (u32 col = 0; col < q; col++) {
+        for (u32 row = 0; row < q; row++) {
+          std::vector<u32> expected;
+          for (u32 other = 0; other < q; other++) {
+            if (linked[sub][(other + q - row) % q]) {
+              expected.push_back(SlimflyGraph::routerId(sub, col, other, q));
+            }
+            // (0, x, y) - (1, m, c): c = y - m*x and y = m*x + c
+            if (sub == 0) {
+              u32 c = (row + q - (other * col) % q) % q;
+              expected.push_back(SlimflyGraph::routerId(1, other, c, q));
+            } else {
+              u32 y = (other * col + row) % q;
+              expected.push_back(SlimflyGraph::routerId(0, other, y, q));
+            }
+          }
+          u32 node = SlimflyGraph::routerId(sub, col, row, q);
+          std::vector<u32> actual(
+              graph.neighbors().begin() + graph.offsets()[node],
+              graph.neighbors().begin() + graph.offsets()[node + 1]);
+          std::sort(expected.begin(), expected.end());
+          std::sort(actual.begin(), actual.end());
+          ASSERT_EQ(actual, expected) << "width " << q << " router " << node;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SpectralBisector.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SPECTRAL_AVX2
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+static const f64 kImbalance = 1.03;
+
+/*
+ * Both kernels sum the neighbors in four interleaved lanes, so they round
+ * identically and the partition does not depend on the CPU it was computed
+ * on.
+ */
+void SpectralBisector::laplacianTimesScalar(const std::vector<u32>& _offsets,
+                                            const std::vector<u32>& _neighbors,
+                                            const f64* _x, f64* _y) {
+  u32 nvtxs = _offsets.size() - 1;
+  const u32* adj = _neighbors.data();
+  for (u32 v = 0; v < nvtxs; v++) {
+    u32 e = _offsets[v];
+    u32 end = _offsets[v + 1];
+    f64 lanes[4] = {0, 0, 0, 0};
+    for (; e + 4 <= end; e += 4) {
+      lanes[0] += _x[adj[e]];
+      lanes[1] += _x[adj[e + 1]];
+      lanes[2] += _x[adj[e + 2]];
+      lanes[3] += _x[adj[e + 3]];
+    }
+    f64 sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; e < end; e++) {
+      sum += _x[adj[e]];
+    }
+    _y[v] = (end - _offsets[v]) * _x[v] - sum;
+  }
+}
+
+#ifdef SPECTRAL_AVX2
+/* The same with AVX2 gathers. It is compiled for AVX2 on its own, the rest
+ * of the build keeps the baseline instruction set, and only called when the
+ * CPU supports it.
+ */
+__attribute__((target("avx2")))
+static void laplacianTimesGather(const std::vector<u32>& _offsets,
+                                 const std::vector<u32>& _neighbors,
+                                 const f64* _x, f64* _y) {
+  u32 nvtxs = _offsets.size() - 1;
+  const u32* adj = _neighbors.data();
+  const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  for (u32 v = 0; v < nvtxs; v++) {
+    u32 e = _offsets[v];
+    u32 end = _offsets[v + 1];
+    __m256d acc = _mm256_setzero_pd();
+    for (; e + 4 <= end; e += 4) {
+      __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(adj + e));
+      acc = _mm256_add_pd(acc, _mm256_mask_i32gather_pd(
+          _mm256_setzero_pd(), _x, idx, all, 8));
+    }
+    f64 lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    f64 sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; e < end; e++) {
+      sum += _x[adj[e]];
+    }
+    _y[v] = (end - _offsets[v]) * _x[v] - sum;
+  }
+}
+#endif
+
+bool SpectralBisector::laplacianTimesAvx2(const std::vector<u32>& _offsets,
+                                          const std::vector<u32>& _neighbors,
+                                          const f64* _x, f64* _y) {
+#ifdef SPECTRAL_AVX2
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  if (avx2) {
+    laplacianTimesGather(_offsets, _neighbors, _x, _y);
+    return true;
+  }
+#else
+  (void)_offsets;  // unused
+  (void)_neighbors;  // unused
+  (void)_x;  // unused
+  (void)_y;  // unused
+#endif
+  return false;
+}
+
+static void laplacianTimes(const std::vector<u32>& _offsets,
+                           const std::vector<u32>& _neighbors,
+                           const f64* _x, f64* _y) {
+  if (!SpectralBisector::laplacianTimesAvx2(_offsets, _neighbors, _x, _y)) {
+    SpectralBisector::laplacianTimesScalar(_offsets, _neighbors, _x, _y);
+  }
+}
+
+static f64 dot(const std::vector<f64>& _a, const std::vector<f64>& _b) {
+  return std::inner_product(_a.begin(), _a.end(), _b.begin(), 0.0);
+}
+
+// removes the component along the constant vector (the null space of L)
+static void deflate(std::vector<f64>* _v) {
+  f64 mean = std::accumulate(_v->begin(), _v->end(), 0.0) / _v->size();
+  for (f64& value : *_v) {
+    value -= mean;
+  }
+}
+
+/*
+ * Eigen decomposition of a symmetric tridiagonal matrix with the implicit QL
+ * method. _diag receives the eigenvalues and the columns of _vecs (m x m, row
+ * major) the eigenvectors.
+ */
+static void tridiagonalEigen(std::vector<f64>* _diag, std::vector<f64> _off,
+                             std::vector<f64>* _vecs) {
+  std::vector<f64>& d = *_diag;
+  std::vector<f64>& z = *_vecs;
+  s32 m = d.size();
+  z.assign(m * m, 0.0);
+  for (s32 i = 0; i < m; i++) {
+    z[i * m + i] = 1.0;
+  }
+  _off.push_back(0.0);
+  for (s32 l = 0; l < m; l++) {
+    for (u32 iter = 0; iter < 64; iter++) {
+      s32 n;
+      for (n = l; n < m - 1; n++) {
+        f64 dd = std::fabs(d[n]) + std::fabs(d[n + 1]);
+        if (std::fabs(_off[n]) <= 1e-15 * dd) {
+          break;
+        }
+      }
+      if (n == l) {
+        break;
+      }
+      f64 g = (d[l + 1] - d[l]) / (2.0 * _off[l]);
+      f64 r = std::hypot(g, 1.0);
+      g = d[n] - d[l] + _off[l] / (g + (g >= 0 ? r : -r));
+      f64 s = 1.0;
+      f64 c = 1.0;
+      f64 p = 0.0;
+      s32 i;
+      for (i = n - 1; i >= l; i--) {
+        f64 f = s * _off[i];
+        f64 b = c * _off[i];
+        r = std::hypot(f, g);
+        _off[i + 1] = r;
+        if (r == 0.0) {
+          d[i + 1] -= p;
+          _off[n] = 0.0;
+          break;
+        }
+        s = f / r;
+        c = g / r;
+        g = d[i + 1] - p;
+        r = (d[i] - g) * s + 2.0 * c * b;
+        p = s * r;
+        d[i + 1] = g + p;
+        g = c * r - b;
+        for (s32 k = 0; k < m; k++) {
+          f = z[k * m + i + 1];
+          z[k * m + i + 1] = s * z[k * m + i] + c * f;
+          z[k * m + i] = c * z[k * m + i] - s * f;
+        }
+      }
+      if (r == 0.0 && i >= l) {
+        continue;
+      }
+      d[l] -= p;
+      _off[l] = g;
+      _off[n] = 0.0;
+    }
+  }
+}
+
+SpectralBisector::SpectralBisector(u64 _seed, u32 _iterations)
+    : seed_(_seed), iterations_(_iterations) {}
+
+SpectralBisector::~SpectralBisector() {}
+
+u64 SpectralBisector::edgeCut(const std::vector<u32>& _offsets,
+                              const std::vector<u32>& _neighbors,
+                              u64 _trial) const {
+  return sweep(_offsets, _neighbors, _trial, nullptr);
+}
+
+u64 SpectralBisector::split(const std::vector<u32>& _offsets,
+                            const std::vector<u32>& _neighbors, u64 _trial,
+                            std::vector<u8>* _where) const {
+  return sweep(_offsets, _neighbors, _trial, _where);
+}
+
+u64 SpectralBisector::sweep(const std::vector<u32>& _offsets,
+                            const std::vector<u32>& _neighbors, u64 _trial,
+                            std::vector<u8>* _where) const {
+  u32 nvtxs = _offsets.size() - 1;
+  if (nvtxs < 2) {
+    if (_where) {
+      _where->assign(nvtxs, 0);
+    }
+    return 0;
+  }
+
+  // random start vector orthogonal to the constant vector
+  std::mt19937_64 random(trialSeed(seed_, _trial));
+  std::uniform_real_distribution<f64> uniform(-1.0, 1.0);
+  std::vector<f64> v(nvtxs);
+  for (f64& value : v) {
+    value = uniform(random);
+  }
+  deflate(&v);
+  f64 norm = std::sqrt(dot(v, v));
+  for (f64& value : v) {
+    value /= norm;
+  }
+
+  // Lanczos with full reorthogonalization
+  u32 steps = std::min<u32>(iterations_, nvtxs - 1);
+  std::vector<std::vector<f64> > basis;
+  std::vector<f64> alpha;
+  std::vector<f64> beta;
+  std::vector<f64> w(nvtxs);
+  basis.reserve(steps);
+  for (u32 j = 0; j < steps; j++) {
+    basis.push_back(v);
+    laplacianTimes(_offsets, _neighbors, basis[j].data(), w.data());
+    alpha.push_back(dot(w, basis[j]));
+    f64 scale = std::sqrt(dot(w, w));
+    // two passes keep the basis orthogonal near an invariant subspace
+    for (u32 pass = 0; pass < 2; pass++) {
+      for (u32 i = 0; i <= j; i++) {
+        f64 proj = dot(w, basis[i]);
+        for (u32 k = 0; k < nvtxs; k++) {
+          w[k] -= proj * basis[i][k];
+        }
+      }
+      deflate(&w);
+    }
+    f64 b = std::sqrt(dot(w, w));
+    if (j + 1 == steps || b <= 1e-8 * scale) {
+      break;
+    }
+    beta.push_back(b);
+    for (u32 k = 0; k < nvtxs; k++) {
+      v[k] = w[k] / b;
+    }
+  }
+
+  // the smallest Ritz pair approximates the Fiedler pair
+  u32 m = alpha.size();
+  std::vector<f64> ritz(alpha);
+  std::vector<f64> vecs;
+  beta.resize(m - 1);
+  tridiagonalEigen(&ritz, beta, &vecs);
+  u32 best = std::min_element(ritz.begin(), ritz.end()) - ritz.begin();
+  std::vector<f64> fiedler(nvtxs, 0.0);
+  for (u32 j = 0; j < m; j++) {
+    f64 coeff = vecs[j * m + best];
+    for (u32 k = 0; k < nvtxs; k++) {
+      fiedler[k] += coeff * basis[j][k];
+    }
+  }
+
+  // sweep the vertices in Fiedler order, tracking the cut incrementally
+  std::vector<u32> order(nvtxs);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+      return fiedler[a] < fiedler[b];
+    });
+  u32 maxPart = static_cast<u32>(std::ceil((nvtxs / 2.0) * kImbalance));
+  u32 minPart = (maxPart >= nvtxs) ? 1 : nvtxs - maxPart;
+  std::vector<u8> side(nvtxs, 0);
+  s64 cut = 0;
+  u64 bestCut = U64_MAX;
+  u32 bestSize = 0;
+  for (u32 idx = 0; idx < maxPart && idx + 1 < nvtxs; idx++) {
+    u32 u = order[idx];
+    side[u] = 1;
+    for (u32 e = _offsets[u]; e < _offsets[u + 1]; e++) {
+      cut += side[_neighbors[e]] ? -1 : 1;
+    }
+    if (idx + 1 >= minPart && static_cast<u64>(cut) < bestCut) {
+      bestCut = cut;
+      bestSize = idx + 1;
+    }
+  }
+
+  // the best sweep position splits the Fiedler order in two
+  if (_where) {
+    _where->assign(nvtxs, 0);
+    for (u32 idx = 0; idx < bestSize; idx++) {
+      (*_where)[order[idx]] = 1;
+    }
+  }
+  return bestCut;
+}
+
+std::string SpectralBisector::settings() const {
+  return "spectral seed=" + std::to_string(seed_) +
+      " iterations=" + std::to_string(iterations_);
+}
+
+f64 SpectralBisector::imbalance() const {
+  return kImbalance;
+}
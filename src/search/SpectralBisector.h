@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_SPECTRALBISECTOR_H_
+#define SEARCH_SPECTRALBISECTOR_H_
+
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "search/Bisector.h"
+
+/*
+ * A fast estimating bisector. It approximates the Fiedler vector (the
+ * eigenvector of the second smallest Laplacian eigenvalue) with a fixed
+ * number of Lanczos iterations over the CSR graph, orders the vertices by
+ * their Fiedler value, and takes the smallest cut over all sweep positions
+ * inside the balance window. It is meant for first pass screening. The cut
+ * it returns is a real cut, so it is still an upper bound.
+ */
+class SpectralBisector : public Bisector {
+ public:
+  SpectralBisector(u64 _seed, u32 _iterations);
+  ~SpectralBisector();
+  u64 edgeCut(const std::vector<u32>& _offsets,
+              const std::vector<u32>& _neighbors,
+              u64 _trial) const override;
+  u64 split(const std::vector<u32>& _offsets,
+            const std::vector<u32>& _neighbors, u64 _trial,
+            std::vector<u8>* _where) const override;
+  std::string settings() const override;
+  f64 imbalance() const override;
+
+  /*
+   * y = L x for the graph Laplacian L = D - A. The AVX2 kernel returns false
+   * and leaves _y alone if it wasn't compiled in or the CPU lacks AVX2, the
+   * bisector then falls back to the scalar one. Both round identically.
+   */
+  static void laplacianTimesScalar(const std::vector<u32>& _offsets,
+                                   const std::vector<u32>& _neighbors,
+                                   const f64* _x, f64* _y);
+  static bool laplacianTimesAvx2(const std::vector<u32>& _offsets,
+                                 const std::vector<u32>& _neighbors,
+                                 const f64* _x, f64* _y);
+
+ private:
+  u64 sweep(const std::vector<u32>& _offsets,
+            const std::vector<u32>& _neighbors, u64 _trial,
+            std::vector<u8>* _where) const;
+
+  u64 seed_;
+  u32 iterations_;
+};
+
+#endif  // SEARCH_SPECTRALBISECTOR_H_
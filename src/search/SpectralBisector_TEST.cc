@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/SpectralBisector.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "search/BisectionBounds.h"
+#include "search/SlimflyGraph.h"
+#include "search/util.h"
+
+TEST(SpectralBisector, slimflyCuts) {
+  SpectralBisector bisector(12345, 64);
+  for (u32 width : primePowers(4, 27)) {
+    s32 delta = SlimflyGraph::deltaOf(width);
+    SlimflyGraph graph(width, delta);
+    u64 maxPart = static_cast<u64>(
+        std::ceil(graph.numNodes() / 2.0 * bisector.imbalance()));
+    BisectionBounds bounds = computeBisectionBounds(width, delta,
+                                                    bisector.imbalance());
+    for (u64 trial = 0; trial < 2; trial++) {
+      std::vector<u8> where;
+      u64 cut = bisector.split(graph.offsets(), graph.neighbors(), trial,
+                               &where);
+      EXPECT_EQ(cut, bisector.edgeCut(graph.offsets(), graph.neighbors(),
+                                      trial));
+
+      // the sweep's cut is the cut of the returned partition, which is
+      //  within the imbalance and no better than the lower bound
+      ASSERT_EQ(where.size(), graph.numNodes());
+      u64 sizes[2] = {0, 0};
+      for (u8 part : where) {
+        sizes[part]++;
+      }
+      EXPECT_EQ(cut, Bisector::countCut(graph.offsets(), graph.neighbors(),
+                                        where)) << "width " << width;
+      EXPECT_LE(sizes[0], maxPart) << "width " << width;
+      EXPECT_LE(sizes[1], maxPart) << "width " << width;
+      EXPECT_LE(bounds.lower, cut) << "width " << width;
+    }
+  }
+}
+
+TEST(SpectralBisector, kernels) {
+  // the AVX2 kernel, where the CPU has it, matches the scalar one exactly
+  SlimflyGraph graph(25, SlimflyGraph::deltaOf(25));
+  u32 n = graph.numNodes();
+  std::mt19937_64 random(3);
+  std::uniform_real_distribution<f64> uniform(-1.0, 1.0);
+  std::vector<f64> x(n);
+  for (f64& value : x) {
+    value = uniform(random);
+  }
+  std::vector<f64> scalar(n);
+  SpectralBisector::laplacianTimesScalar(graph.offsets(), graph.neighbors(),
+                                         x.data(), scalar.data());
+
+  // L 1 = 0 and x' L x is the sum of (x_u - x_v)^2 over the channels
+  std::vector<f64> ones(n, 1.0);
+  std::vector<f64> zero(n);
+  SpectralBisector::laplacianTimesScalar(graph.offsets(), graph.neighbors(),
+                                         ones.data(), zero.data());
+  f64 quadratic = 0;
+  f64 expected = 0;
+  for (u32 node = 0; node < n; node++) {
+    EXPECT_EQ(zero[node], 0.0);
+    quadratic += x[node] * scalar[node];
+    for (u32 e = graph.offsets()[node]; e < graph.offsets()[node + 1]; e++) {
+      f64 diff = x[node] - x[graph.neighbors()[e]];
+      expected += diff * diff / 2;
+    }
+  }
+  EXPECT_NEAR(quadratic, expected, 1e-9 * expected);
+
+  std::vector<f64> avx2(n, -1.0);
+  if (!SpectralBisector::laplacianTimesAvx2(graph.offsets(),
+                                            graph.neighbors(), x.data(),
+                                            avx2.data())) {
+    return;
+  }
+  for (u32 node = 0; node < n; node++) {
+    EXPECT_EQ(avx2[node], scalar[node]) << "router " << node;
+  }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_STATICCALCULATOR_H_
+#define SEARCH_STATICCALCULATOR_H_
+
+#include <prim/prim.h>
+
+#include "search/Calculator.h"
+#include "search/Engine.h"
+#include "search/SlimflyBlock.h"
+
+/*
+ * Base class for calculators whose cost is a plain function of the Slimfly
+ * fields. Derived provides
+ *   static f64 costOf(u64 _width, u64 _concentration, u64 _terminals,
+ *                     u64 _routers, u64 _routerRadix, u64 _channels,
+ *                     f64 _bisections);
+ *   static f64 costBoundOf(u64 _width, u64 _concentration, u64 _terminals,
+ *                          u64 _routers, u64 _routerRadix, u64 _channels);
+ * where costBoundOf() is a lower bound of costOf() over all bisections, and
+ * this class implements cost(), the batch costs() and costBounds() with them.
+ * The batch loops cost a single virtual call per block and the formula is
+ * inlined into them, so simple costs vectorize over the block's columns.
+ */
+template <typename Derived>
+class StaticCalculator : public Calculator {
+ public:
+  StaticCalculator();
+  virtual ~StaticCalculator();
+  f64 cost(const Slimfly& _slimfly) const override;
+  void costs(SlimflyBlock* _block) const override;
+  bool costBounds(SlimflyBlock* _block) const override;
+};
+
+#include "search/StaticCalculator.tcc"
+
+#endif  // SEARCH_STATICCALCULATOR_H_
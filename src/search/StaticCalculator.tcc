@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_STATICCALCULATOR_H_
+#error "do not include this file, use the .h instead"
+#else  // SEARCH_STATICCALCULATOR_H_
+
+template <typename Derived>
+StaticCalculator<Derived>::StaticCalculator() {}
+
+template <typename Derived>
+StaticCalculator<Derived>::~StaticCalculator() {}
+
+template <typename Derived>
+f64 StaticCalculator<Derived>::cost(const Slimfly& _slimfly) const {
+  return Derived::costOf(_slimfly.width, _slimfly.concentration,
+                         _slimfly.terminals, _slimfly.routers,
+                         _slimfly.routerRadix, _slimfly.channels,
+                         _slimfly.bisections);
+}
+
+template <typename Derived>
+void StaticCalculator<Derived>::costs(SlimflyBlock* _block) const {
+  u64 size = _block->size();
+  const u64* width = _block->width.data();
+  const u64* concentration = _block->concentration.data();
+  const u64* terminals = _block->terminals.data();
+  const u64* routers = _block->routers.data();
+  const u64* routerRadix = _block->routerRadix.data();
+  const u64* channels = _block->channels.data();
+  const f64* bisections = _block->bisections.data();
+  f64* cost = _block->cost.data();
+  for (u64 idx = 0; idx < size; idx++) {
+    cost[idx] = Derived::costOf(width[idx], concentration[idx],
+                                terminals[idx], routers[idx],
+                                routerRadix[idx], channels[idx],
+                                bisections[idx]);
+  }
+}
+
+template <typename Derived>
+bool StaticCalculator<Derived>::costBounds(SlimflyBlock* _block) const {
+  u64 size = _block->size();
+  const u64* width = _block->width.data();
+  const u64* concentration = _block->concentration.data();
+  const u64* terminals = _block->terminals.data();
+  const u64* routers = _block->routers.data();
+  const u64* routerRadix = _block->routerRadix.data();
+  const u64* channels = _block->channels.data();
+  f64* cost = _block->cost.data();
+  for (u64 idx = 0; idx < size; idx++) {
+    cost[idx] = Derived::costBoundOf(width[idx], concentration[idx],
+                                     terminals[idx], routers[idx],
+                                     routerRadix[idx], channels[idx]);
+  }
+  return true;
+}
+
+#endif  // SEARCH_STATICCALCULATOR_H_
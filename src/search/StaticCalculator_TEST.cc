@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/StaticCalculator.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <random>
+#include <vector>
+
+#include "search/RouterChannelCount.h"
+#include "search/SlimflyBlock.h"
+
+namespace {
+
+// only the per row cost, so the batch passes take the CostFunction defaults
+class RowCost : public CostFunction {
+ public:
+  f64 cost(const Slimfly& _slimfly) const override {
+    return _slimfly.routers * _slimfly.bisections + _slimfly.terminals;
+  }
+};
+
+// a block of plausible rows, cost is filled by the calculator under test
+SlimflyBlock makeBlock() {
+  std::mt19937_64 random(5);
+  std::uniform_int_distribution<u64> width(5, 200);
+  std::uniform_int_distribution<u64> concentration(1, 100);
+  std::uniform_real_distribution<f64> bisection(0.1, 1.5);
+  SlimflyBlock block;
+  for (u32 row = 0; row < 500; row++) {
+    Slimfly slimfly;
+    slimfly.dimensions = 2;
+    slimfly.width = width(random);
+    slimfly.routers = 2 * slimfly.width * slimfly.width;
+    slimfly.concentration = concentration(random);
+    slimfly.terminals = slimfly.routers * slimfly.concentration;
+    slimfly.routerRadix = (3 * slimfly.width + 1) / 2 +
+        slimfly.concentration;
+    slimfly.channels = slimfly.routers * (3 * slimfly.width + 1) / 4;
+    slimfly.bisections = bisection(random);
+    slimfly.cost = -1;
+    block.push(slimfly);
+  }
+  return block;
+}
+
+}  // namespace
+
+TEST(StaticCalculator, costs) {
+  // the batch pass computes exactly what cost() does row by row
+  RouterChannelCount calc;
+  SlimflyBlock block = makeBlock();
+  calc.costs(&block);
+  for (u64 row = 0; row < block.size(); row++) {
+    Slimfly slimfly = block.get(row);
+    EXPECT_EQ(block.cost[row], calc.cost(slimfly)) << "row " << row;
+    EXPECT_EQ(block.cost[row], slimfly.routers + slimfly.channels * 1e-9);
+  }
+}
+
+TEST(StaticCalculator, costBounds) {
+  // the bound never exceeds the cost, for the router count it is exact
+  RouterChannelCount calc;
+  SlimflyBlock block = makeBlock();
+  ASSERT_TRUE(calc.costBounds(&block));
+  for (u64 row = 0; row < block.size(); row++) {
+    Slimfly slimfly = block.get(row);
+    EXPECT_LE(block.cost[row], calc.cost(slimfly)) << "row " << row;
+    EXPECT_EQ(block.cost[row], calc.cost(slimfly)) << "row " << row;
+  }
+}
+
+TEST(StaticCalculator, defaults) {
+  // a plain cost function costs one row at a time and has no bounds
+  RowCost calc;
+  SlimflyBlock block = makeBlock();
+  std::vector<f64> before = block.cost;
+  EXPECT_FALSE(calc.costBounds(&block));
+  EXPECT_EQ(block.cost, before);
+  calc.costs(&block);
+  for (u64 row = 0; row < block.size(); row++) {
+    EXPECT_EQ(block.cost[row], calc.cost(block.get(row))) << "row " << row;
+  }
+}
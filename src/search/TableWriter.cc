@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/TableWriter.h"
+
+#include <grid/Grid.h>
+
+#include <string>
+#include <vector>
+
+TableWriter::TableWriter(const Calculator* _calc, FILE* _out)
+    : ResultWriter(_calc, _out) {}
+
+TableWriter::~TableWriter() {}
+
+void TableWriter::finish(const std::deque<Slimfly>& _results) {
+  // create the output grid
+  const std::vector<std::string>& extFields = calc_->extFields();
+  grid::Grid grid(1 + _results.size(), 11 + extFields.size());
+
+  // format the regular header
+  grid.set(0, 0, "#");
+  grid.set(0, 1, "Dimensions");
+  grid.set(0, 2, "Width");
+  grid.set(0, 3, "Concentration");
+  grid.set(0, 4, "Terminals");
+  grid.set(0, 5, "Routers");
+  grid.set(0, 6, "Radix");
+  grid.set(0, 7, "Channels");
+  grid.set(0, 8, "Bisection");
+  grid.set(0, 9, "Cost");
+
+  // format the extension header
+  for (u64 ext = 0; ext < extFields.size(); ext++) {
+    grid.set(0, 11 + ext, extFields.at(ext));
+  }
+
+  // format the data section
+  for (u64 idx = 0; idx < _results.size(); idx++) {
+    u64 row = idx + 1;
+
+    // get the results
+    const Slimfly& res = _results.at(idx);
+
+    // format the regular values in the row
+    grid.set(row, 0, std::to_string(row));
+    grid.set(row, 1, std::to_string(res.dimensions));
+    grid.set(row, 2, std::to_string(res.width));
+    grid.set(row, 3, std::to_string(res.concentration));
+    grid.set(row, 4, std::to_string(res.terminals));
+    grid.set(row, 5, std::to_string(res.routers));
+    grid.set(row, 6, std::to_string(res.routerRadix));
+    grid.set(row, 7, std::to_string(res.channels));
+    grid.set(row, 8, std::to_string(res.bisections));
+    grid.set(row, 9, std::to_string(res.cost));
+
+    // get extension values from the calculator
+    calc_->fillExtValues(res, &extValues_);
+
+    // format the extensions values in the row
+    for (u64 ext = 0; ext < extFields.size(); ext++) {
+      grid.set(row, 11 + ext, extValues_.at(ext));
+    }
+  }
+
+  // print the output grid
+  fprintf(out_, "%s", grid.toString().c_str());
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/WorkPool.h"
+
+#include <algorithm>
+
+// index of the queue owned by the current thread, external callers use the
+//  last queue
+static thread_local s32 tlsQueue = -1;
+
+WorkPool::WorkPool(u32 _threads)
+    : threads_(std::max<u32>(1, _threads)),
+      queues_(threads_),
+      pending_(0),
+      stop_(false) {
+  for (u32 idx = 0; idx + 1 < threads_; idx++) {
+    workers_.push_back(std::thread(&WorkPool::work, this, idx));
+  }
+}
+
+WorkPool::~WorkPool() {
+  {
+    std::lock_guard<std::mutex> guard(sleepLock_);
+    stop_ = true;
+  }
+  wakeup_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+u32 WorkPool::threads() const {
+  return threads_;
+}
+
+void WorkPool::parallelFor(u64 _count,
+                           const std::function<void(u64)>& _task) {
+  if (threads_ == 1 || _count < 2) {
+    for (u64 idx = 0; idx < _count; idx++) {
+      _task(idx);
+    }
+    return;
+  }
+
+  // deal the tasks out round robin, stealing evens out the rest
+  Group group;
+  group.remaining = _count;
+  group.failed = false;
+  {
+    std::lock_guard<std::mutex> guard(sleepLock_);
+    pending_ += _count;
+  }
+  for (u64 idx = 0; idx < _count; idx++) {
+    Queue& queue = queues_[idx % threads_];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.tasks.push_back({&_task, idx, &group});
+  }
+  wakeup_.notify_all();
+
+  // help until every task of this group has completed
+  u32 me = self();
+  while (group.remaining > 0) {
+    if (!runOne(me)) {
+      std::this_thread::yield();
+    }
+  }
+  if (group.failed) {
+    std::rethrow_exception(group.error);
+  }
+}
+
+void WorkPool::work(u32 _self) {
+  tlsQueue = _self;
+  while (true) {
+    if (runOne(_self)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(sleepLock_);
+    wakeup_.wait(guard, [this] { return stop_ || pending_ > 0; });
+    if (stop_) {
+      return;
+    }
+  }
+}
+
+bool WorkPool::runOne(u32 _self) {
+  Task task;
+  bool found = false;
+
+  // take from the back of our own queue first
+  {
+    Queue& queue = queues_[_self];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (!queue.tasks.empty()) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      found = true;
+    }
+  }
+
+  // otherwise steal from the front of another queue
+  for (u32 offset = 1; !found && offset < threads_; offset++) {
+    Queue& queue = queues_[(_self + offset) % threads_];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (!queue.tasks.empty()) {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      found = true;
+    }
+  }
+
+  if (!found) {
+    return false;
+  }
+  pending_--;
+
+  /* The group must always count the task as done, the caller waits on it and
+   * the group lives on the caller's stack. The first exception is kept for
+   * the caller, only the task that flips the flag writes it.
+   */
+  Group* group = task.group;
+  if (!group->failed) {
+    try {
+      (*task.function)(task.index);
+    } catch (...) {
+      if (!group->failed.exchange(true)) {
+        group->error = std::current_exception();
+      }
+    }
+  }
+  group->remaining--;
+  return true;
+}
+
+u32 WorkPool::self() const {
+  return (tlsQueue < 0) ? threads_ - 1 : static_cast<u32>(tlsQueue);
+}
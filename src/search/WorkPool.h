@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SEARCH_WORKPOOL_H_
+#define SEARCH_WORKPOOL_H_
+
+#include <prim/prim.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * This is a small work stealing thread pool. Each participating thread owns a
+ * task queue, pops its own work from the back and steals from the front of
+ * other queues when it runs dry. The thread calling parallelFor() takes part
+ * in the work, so parallelFor() may also be called from inside a task.
+ */
+class WorkPool {
+ public:
+  explicit WorkPool(u32 _threads);
+  ~WorkPool();
+
+  u32 threads() const;
+
+  // runs _task(0) ... _task(_count - 1) and returns when all have finished.
+  //  if tasks throw, the tasks not yet started are skipped and the first
+  //  exception is rethrown here.
+  void parallelFor(u64 _count, const std::function<void(u64)>& _task);
+
+ private:
+  struct Group {
+    std::atomic<u64> remaining;
+    std::atomic<bool> failed;
+    std::exception_ptr error;  // the first exception thrown by a task
+  };
+  struct Task {
+    const std::function<void(u64)>* function;
+    u64 index;
+    Group* group;
+  };
+  struct Queue {
+    std::mutex lock;
+    std::deque<Task> tasks;
+  };
+
+  u32 threads_;
+  std::vector<Queue> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<u64> pending_;
+  std::atomic<bool> stop_;
+  std::mutex sleepLock_;
+  std::condition_variable wakeup_;
+
+  void work(u32 _self);
+  bool runOne(u32 _self);
+  u32 self() const;
+};
+
+#endif  // SEARCH_WORKPOOL_H_
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/WorkPool.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(WorkPool, runsEveryTask) {
+  for (u32 threads : {1u, 2u, 4u}) {
+    WorkPool pool(threads);
+    std::vector<u64> hits(1000, 0);
+    pool.parallelFor(hits.size(), [&](u64 idx) {
+        hits[idx]++;
+      });
+    for (u64 hit : hits) {
+      EXPECT_EQ(hit, 1u);
+    }
+  }
+}
+
+TEST(WorkPool, nested) {
+  WorkPool pool(4);
+  std::atomic<u64> sum(0);
+  pool.parallelFor(8, [&](u64 outer) {
+      pool.parallelFor(100, [&](u64 inner) {
+          sum += outer * 100 + inner;
+        });
+    });
+  EXPECT_EQ(sum.load(), 799u * 800u / 2u);
+}
+
+TEST(WorkPool, rethrows) {
+  for (u32 threads : {1u, 4u}) {
+    WorkPool pool(threads);
+    EXPECT_THROW(pool.parallelFor(100, [&](u64 idx) {
+        if (idx % 10 == 3) {
+          throw std::runtime_error("task failed");
+        }
+      }), std::runtime_error);
+
+    // the pool keeps working after a failed group
+    std::atomic<u64> count(0);
+    pool.parallelFor(100, [&](u64) {
+        count++;
+      });
+    EXPECT_EQ(count.load(), 100u);
+  }
+}
@@ -14,59 +14,199 @@
  * limitations under the License.
  */
 #include "util.h"
-#include <math.h>
 #include <cassert>
-#include <set>
-#include <iostream>
+#include "search/GaloisField.h"
 
-static const u32 numPrimes = 52;
-static const u32 kPrimes[] = {5, 7, 11, 13, 17, 19, 23, 29, 31, 37,
-  41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113,
-  127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197,
-  199, 211, 223, 227, 229, 233, 239, 241, 251};
-static const std::set<u32> kPrimeSet(kPrimes, kPrimes + numPrimes);
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+static const u32 kSegmentSize = 32768;
+
+/* Function to find all primes up to a limit with a segmented sieve. */
+std::vector<u32> sievePrimes(u32 _limit) {
+  std::vector<u32> primes;
+  if (_limit < 2) {
+    return primes;
+  }
+
+  // simple sieve for the base primes up to sqrt(limit)
+  u32 root = static_cast<u32>(std::sqrt(static_cast<f64>(_limit)));
+  while (static_cast<u64>(root + 1) * (root + 1) <= _limit) {
+    root++;
+  }
+  std::vector<u8> composite(root + 1, 0);
+  std::vector<u32> base;
+  for (u32 n = 2; n <= root; n++) {
+    if (!composite[n]) {
+      base.push_back(n);
+      for (u64 m = static_cast<u64>(n) * n; m <= root; m += n) {
+        composite[m] = 1;
+      }
+    }
+  }
+
+  // sieve the full range one cache sized segment at a time
+  std::vector<u8> segment(kSegmentSize);
+  for (u64 low = 2; low <= _limit; low += kSegmentSize) {
+    u64 high = std::min<u64>(low + kSegmentSize - 1, _limit);
+    std::fill(segment.begin(), segment.end(), 0);
+    for (u32 prime : base) {
+      u64 square = static_cast<u64>(prime) * prime;
+      if (square > high) {
+        break;
+      }
+      u64 start = std::max(square, ((low + prime - 1) / prime) * prime);
+      for (u64 m = start; m <= high; m += prime) {
+        segment[m - low] = 1;
+      }
+    }
+    for (u64 n = low; n <= high; n++) {
+      if (!segment[n - low]) {
+        primes.push_back(n);
+      }
+    }
+  }
+  return primes;
+}
+
+/* Function to find all prime powers p^k (k >= 1) in [_min, _limit]. */
+std::vector<u32> primePowers(u32 _min, u32 _limit) {
+  std::vector<u32> powers;
+  for (u32 prime : sievePrimes(_limit)) {
+    for (u64 power = prime; power <= _limit; power *= prime) {
+      if (power >= _min) {
+        powers.push_back(power);
+      }
+    }
+  }
+  std::sort(powers.begin(), powers.end());
+  return powers;
+}
 
 /* Function to determine if a given width is prime. */
 bool isPrime(u32 _width) {
-  assert(_width < kPrimes[numPrimes - 1]);
-  return (kPrimeSet.count(_width) != 0);
+  u32 prime, exponent;
+  return isPrimePower(_width, &prime, &exponent) && exponent == 1;
 }
 
-/* Function to determine if the width has a primitive element. */
-static bool isPrimitiveElement(u32 _width, u32 prim) {
-  std::vector<bool> satisfy(_width, false);
-  satisfy[0] = true;  // exception for primitive elem
-  u32 value = 1;
-  for (u32 p = 0; p < _width; p++) {
-    satisfy[value] = true;
-    value = (value * prim) % _width;
+/* Function to determine if the width is a prime power p^k. */
+bool isPrimePower(u32 _width, u32* _prime, u32* _exponent) {
+  if (_width < 2) {
+    return false;
+  }
+
+  // the smallest prime factor is at most sqrt(width)
+  u32 root = static_cast<u32>(std::sqrt(static_cast<f64>(_width))) + 1;
+  u32 prime = _width;
+  for (u32 candidate : sievePrimes(root)) {
+    if (_width % candidate == 0) {
+      prime = candidate;
+      break;
+    }
+  }
+  u32 exponent = 0;
+  u32 rest = _width;
+  while (rest % prime == 0) {
+    rest /= prime;
+    exponent++;
   }
-  bool isprim = true;
-  for (bool s : satisfy) {
-    isprim &= s;
+  if (rest != 1) {
+    return false;
   }
-  return isprim;
+  *_prime = prime;
+  *_exponent = exponent;
+  return true;
 }
 
-/* Function to create the generator set for a computed primitive element. */
-u32 createGeneratorSet(
-    u32 _width, int delta, std::vector<u32>& X, std::vector<u32>& X_i) {
-  u32 prim = 1;
+/* Function to find the distinct prime factors of a value. */
+std::vector<u32> primeFactors(u32 _value) {
+  std::vector<u32> factors;
+  u32 root = static_cast<u32>(std::sqrt(static_cast<f64>(_value))) + 1;
+  for (u32 prime : sievePrimes(root)) {
+    if (_value % prime == 0) {
+      factors.push_back(prime);
+      while (_value % prime == 0) {
+        _value /= prime;
+      }
+    }
+  }
+  if (_value > 1) {
+    factors.push_back(_value);
+  }
+  return factors;
+}
+
+/* Function to compute _base^_exponent mod _modulus. */
+static u32 powMod(u64 _base, u64 _exponent, u32 _modulus) {
+  u64 result = 1 % _modulus;
+  _base %= _modulus;
+  while (_exponent > 0) {
+    if (_exponent & 1) {
+      result = result * _base % _modulus;
+    }
+    _base = _base * _base % _modulus;
+    _exponent >>= 1;
+  }
+  return result;
+}
+
+/* Function to determine if prim generates the multiplicative group of the
+ * prime field GF(_width): prim^((q-1)/p) != 1 for every prime p | q-1.
+ */
+bool isPrimitiveElement(u32 _width, u32 prim) {
+  if (prim % _width == 0) {
+    return false;
+  }
+  for (u32 factor : primeFactors(_width - 1)) {
+    if (powMod(prim, (_width - 1) / factor, _width) == 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Function to find the smallest primitive root of a prime, cached per width. */
+u32 findPrimitiveRoot(u32 _width) {
+  static std::mutex lock;
+  static std::unordered_map<u32, u32> cache;
+  std::lock_guard<std::mutex> guard(lock);
+  std::unordered_map<u32, u32>::const_iterator it = cache.find(_width);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  u32 prim;
   for (prim = 1; prim < _width; prim++) {
-    if (isPrimitiveElement(_width, prim))
+    if (isPrimitiveElement(_width, prim)) {
       break;
+    }
   }
-  assert(prim < _width);
-  u32 last_pow = (delta == 1) ? _width - 3 : _width - 2;
+  assert(_width == 2 || prim < _width);
+  cache[_width] = prim;
+  return prim;
+}
+
+/* Function to create the generator set for a computed primitive element. */
+u32 createGeneratorSet(
+    u32 _width, int delta, std::vector<u32>& X, std::vector<u32>& X_i) {
+  return createGeneratorSet(*GaloisField::get(_width), delta, X, X_i);
+}
+
+/* Function to create the generator sets X and X' = primitive * X of GF(q). */
+u32 createGeneratorSet(
+    const GaloisField& _field, int delta, std::vector<u32>& X,
+    std::vector<u32>& X_i) {
+  u32 width = _field.order();
+  u32 last_pow = (delta == 1) ? width - 3 : width - 2;
   X.clear();
   X_i.clear();
   for (u32 p = 0; p <= last_pow; p += 2) {
-    if ((delta == -1) && p == (_width + 1) / 2) {
+    if ((delta == -1) && p == (width + 1) / 2) {
       p--;
     }
-    u32 val = pow(prim, p);
-    X.push_back(val % _width);
-    X_i.push_back((val * prim) % _width);
+    X.push_back(_field.exp(p));
+    X_i.push_back(_field.exp(p + 1));
   }
   return X.size();
 }
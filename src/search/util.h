@@ -19,9 +19,20 @@
 #include <prim/prim.h>
 #include <vector>
 
+class GaloisField;
+
+std::vector<u32> sievePrimes(u32 _limit);
+std::vector<u32> primePowers(u32 _min, u32 _limit);
 bool isPrime(u32 _width);
+bool isPrimePower(u32 _width, u32* _prime, u32* _exponent);
+std::vector<u32> primeFactors(u32 _value);
+bool isPrimitiveElement(u32 _width, u32 prim);
+u32 findPrimitiveRoot(u32 _width);
 u32 createGeneratorSet(
   u32 _width, int delta, std::vector<u32>& X, std::vector<u32>& X_i);
+u32 createGeneratorSet(
+  const GaloisField& _field, int delta, std::vector<u32>& X,
+  std::vector<u32>& X_i);
 u32 ifaceIdFromAddress(
     const std::vector<u32>& _address, u32 _width);
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016, Franky Romero, Ashish Chaudhari,
+ * Wesson Altoyan, Nehal Bhandari
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of prim nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "search/util.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <vector>
+
+// the multiplicative order of _value mod the prime _width, by brute force
+static u32 order(u32 _value, u32 _width) {
+  u64 power = _value % _width;
+  u32 exponent = 1;
+  while (power != 1) {
+    power = power * _value % _width;
+    exponent++;
+  }
+  return exponent;
+}
+
+TEST(util, primePowers) {
+  EXPECT_EQ(primePowers(4, 32), std::vector<u32>({
+      4, 5, 7, 8, 9, 11, 13, 16, 17, 19, 23, 25, 27, 29, 31, 32}));
+  EXPECT_EQ(primePowers(4, 3), std::vector<u32>());
+  EXPECT_EQ(primePowers(2, 2), std::vector<u32>({2}));
+}
+
+TEST(util, sievePrimes) {
+  // segments hold 32768 numbers from 2 on, check across a few boundaries
+  std::vector<u32> expected;
+  for (u32 n = 2; n <= 100000; n++) {
+    bool prime = true;
+    for (u32 d = 2; d * d <= n && prime; d++) {
+      prime = n % d != 0;
+    }
+    if (prime) {
+      expected.push_back(n);
+    }
+  }
+  EXPECT_EQ(sievePrimes(100000), expected);
+  for (u32 limit : {32768u, 32769u, 32770u, 32771u, 65537u, 65538u}) {
+    std::vector<u32> primes = sievePrimes(limit);
+    std::vector<u32> prefix(
+        expected.begin(),
+        std::upper_bound(expected.begin(), expected.end(), limit));
+    EXPECT_EQ(primes, prefix) << limit;
+  }
+  EXPECT_TRUE(sievePrimes(1).empty());
+  EXPECT_EQ(sievePrimes(2), std::vector<u32>({2}));
+}
+
+TEST(util, isPrimePower) {
+  u32 prime;
+  u32 exponent;
+  EXPECT_FALSE(isPrimePower(0, &prime, &exponent));
+  EXPECT_FALSE(isPrimePower(1, &prime, &exponent));
+  EXPECT_FALSE(isPrimePower(12, &prime, &exponent));
+  EXPECT_FALSE(isPrimePower(6561 * 2, &prime, &exponent));
+  ASSERT_TRUE(isPrimePower(6561, &prime, &exponent));
+  EXPECT_EQ(prime, 3u);
+  EXPECT_EQ(exponent, 8u);
+  ASSERT_TRUE(isPrimePower(101, &prime, &exponent));
+  EXPECT_EQ(prime, 101u);
+  EXPECT_EQ(exponent, 1u);
+  EXPECT_TRUE(isPrime(2));
+  EXPECT_FALSE(isPrime(49));
+}
+
+TEST(util, primitiveElements) {
+  // order testing agrees with brute force for every element
+  for (u32 width : sievePrimes(200)) {
+    for (u32 value = 1; value < width; value++) {
+      EXPECT_EQ(isPrimitiveElement(width, value),
+                order(value, width) == width - 1)
+          << "width " << width << " value " << value;
+    }
+  }
+}
+
+TEST(util, findPrimitiveRoot) {
+  EXPECT_EQ(findPrimitiveRoot(7), 3u);
+  EXPECT_EQ(findPrimitiveRoot(23), 5u);
+  EXPECT_EQ(findPrimitiveRoot(41), 6u);
+  EXPECT_EQ(findPrimitiveRoot(71), 7u);
+
+  // the smallest element of order q-1, the cached answer is the same
+  for (u32 width : sievePrimes(2000)) {
+    if (width == 2) {
+      continue;
+    }
+    u32 root = findPrimitiveRoot(width);
+    EXPECT_EQ(order(root, width), width - 1) << "width " << width;
+    for (u32 smaller = 2; smaller < root; smaller++) {
+      EXPECT_NE(order(smaller, width), width - 1) << "width " << width;
+    }
+    EXPECT_EQ(findPrimitiveRoot(width), root);
+  }
+}